@@ -204,6 +204,26 @@ if test "x$enable_memory_pool_no_reuse" = "xyes"; then
   AC_DEFINE([ROSE_USE_MEMORY_POOL_NO_REUSE], [], [Whether to use a special no-reuse mode of memory pools])
 fi
 
+# ************************************************************
+# Option to give each thread its own memory pool free lists so that IR nodes can be allocated and deleted by multiple
+# threads in one process without serializing on a per-class lock.
+# ************************************************************
+
+AC_ARG_ENABLE(thread-local-memory-pools, AS_HELP_STRING([--enable-thread-local-memory-pools], [Enable per-thread free lists for IR node memory pools (default is one free list per IR node type)]))
+AM_CONDITIONAL(ROSE_USE_THREAD_LOCAL_MEMORY_POOLS, [test "x$enable_thread_local_memory_pools" = xyes])
+if test "x$enable_thread_local_memory_pools" = "xyes"; then
+  AC_DEFINE([ROSE_USE_THREAD_LOCAL_MEMORY_POOLS], [], [Whether IR node memory pools use per-thread free lists])
+fi
+
+# ************************************************************
+# Zlib is optional. When it is found, the sections of AST block files (AST_FILE_IO::writeASTToBlockFile) can be compressed.
+# ************************************************************
+
+AC_CHECK_HEADER([zlib.h],
+  [AC_CHECK_LIB([z], [compress2],
+     [AC_DEFINE([ROSE_HAVE_ZLIB], [], [Define if zlib is available.])
+      LIBS="$LIBS -lz"])])
+
 
 # ************************************************************
 # Option to control the size of the generated files by ROSETTA
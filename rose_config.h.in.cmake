@@ -88,6 +88,9 @@
 /* Define if libreadline is available. */
 #cmakedefine ROSE_HAVE_LIBREADLINE
 
+/* Define if zlib is available. */
+#cmakedefine ROSE_HAVE_ZLIB
+
 /* Define to 1 if you have the <byteswap.h> header file. */
 #cmakedefine HAVE_BYTESWAP_H 1
 
@@ -797,6 +800,9 @@
 
 #cmakedefine ROSE_SUPPORT_GNU_EXTENSIONS
 #cmakedefine ROSE_USE_INTERNAL_FRONTEND_DEVELOPMENT
+
+/* Whether IR node memory pools use per-thread free lists */
+#cmakedefine ROSE_USE_THREAD_LOCAL_MEMORY_POOLS
 #cmakedefine ROSE_SUPPORT_MICROSOFT_EXTENSIONS
 
 /* Detect whether our compilers are GNU or not */
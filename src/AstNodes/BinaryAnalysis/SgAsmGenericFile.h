@@ -82,6 +82,8 @@ public:
 private:
     mutable AddressIntervalSet *p_unreferenced_cache = nullptr;
     DataConverter *p_data_converter = nullptr;
+    Rose::BinaryAnalysis::MemoryMap::Buffer::Ptr p_content_buffer; // owns the file content unless it's on the heap
+    static bool p_map_content;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Functions
@@ -133,6 +135,28 @@ public:
     DataConverter* get_data_converter() const {return p_data_converter;}
     /** @} */
 
+    /** Property: Whether file content is mapped into memory.
+     *
+     *  When this global property is set, @ref parse maps each file into memory read-only instead of reading it into a heap
+     *  buffer. The mapping is then used directly as the file content and is also shared by the memory segments that the @ref
+     *  Rose::BinaryAnalysis::BinaryLoader creates for the file, so the file's bytes are present in memory only once. If the file
+     *  has a @ref get_data_converter "data converter" then the mapping is private, a heap copy is made only if the converter
+     *  decodes into a new buffer, and the loader does not share the mapping. If the file cannot be mapped then it is read as
+     *  usual. The default is to read files.
+     *
+     *  This property should not be changed while other threads are parsing files.
+     *
+     * @{ */
+    static bool get_map_content();
+    static void set_map_content(bool);
+    /** @} */
+
+    /** Buffer holding the file content.
+     *
+     *  Returns the buffer whose storage is used by the file content if the file was mapped into memory by @ref parse, or null if
+     *  the content is in a heap buffer owned by this file. */
+    Rose::BinaryAnalysis::MemoryMap::Buffer::Ptr get_content_buffer() const;
+
     /** Returns current size of file based on section with highest ending address. */
     rose_addr_t get_current_size() const;
 
@@ -22,6 +22,9 @@ namespace IO {
  * 
  * This function happens the content of each AST file to the given project.
  * It is used by the command line option: -rose:ast:read.
+ * The files can be written by either AST_FILE_IO::writeASTToFile or AST_FILE_IO::writeASTToBlockFile.
+ * While an AST is rebuilt, the next files are read by other threads (one file per thread, see the -rose:ast:threads option).
+ * The ASTs themselves are rebuilt one after the other as they share the global state of AST_FILE_IO.
  * This function will leave the AST in an inconsistent state and Rose::AST::merge must be run to fix it.
  */
 ROSE_DLL_API void load(SgProject * project, std::list<std::string> const & filepaths);
@@ -34,7 +37,7 @@ ROSE_DLL_API void load(SgProject * project, std::list<std::string> const & filep
  * This function is mainly used after loading ASTs from files.
  * It is used by the command line option: -rose:ast:read and -rose:ast:merge.
  * It simply calls three functions in sequence: Rose::AST::share, Rose::AST::prune, and Rose::AST::link.
- * It also provides statistics if Rose is in verbose > 0.
+ * It also provides statistics if Rose is in verbose > 0, including the time and the number of nodes after each phase.
  *
  */
 ROSE_DLL_API void merge(SgProject * project);
@@ -46,6 +49,9 @@ ROSE_DLL_API void merge(SgProject * project);
  * 
  * This function is mainly used when two or more translation units are merged together.
  * Particularly, the ASTs of header files is duplicated when included from different translation-units.
+ * The nodes are partitioned by the hash of their sharing identifier (based on the mangled name), and the partitions
+ * are deduplicated by different threads (see the -rose:ast:threads option). Computing the identifiers is done by the calling
+ * thread.
  */
 ROSE_DLL_API void share(SgProject * project);
 
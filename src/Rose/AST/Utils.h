@@ -4,6 +4,7 @@
 #include <iostream>
 #include <map>
 #include <ostream>
+#include <vector>
 
 class SgNode;
 
@@ -21,6 +22,10 @@ void edgePointerReplacement(replacement_map_t const &);
 //! Traverse the AST `root` looking for the edges in the replacement map. If a match is found the edge is updated.
 void edgePointerReplacement(SgNode * root, replacement_map_t const &);
 
+//! Looks for the edges of the given nodes in the replacement map, dividing the nodes among `nThreads` threads. If a match is
+//! found the edge is updated. Each node is only modified by the thread that visits it, so the nodes must be distinct.
+void edgePointerReplacement(std::vector<SgNode *> const & nodes, replacement_map_t const &, size_t nThreads);
+
 
 /** Check that all parent pointers in the specified subtree are correct.
  *
@@ -2,6 +2,7 @@
 #ifndef ROSE_AST_CMDLINE_H
 #define ROSE_AST_CMDLINE_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -71,5 +72,10 @@ namespace cmdline {
   };
   extern __when_T<checker_t> checker; //!< Used by the -rose:ast:checker:XXX options
 
+  //! Number of threads used to read AST files ahead of time and to share their nodes, set by the -rose:ast:threads option.
+  //! Zero, the default, means one per hardware thread when sharing, but at most four files read ahead when loading since each
+  //! file that has been read ahead is held in memory.
+  extern size_t threads;
+
 } } }
 #endif /* ROSE_AST_CMDLINE_H */
@@ -4,6 +4,8 @@
 #ifdef ROSE_ENABLE_CONCOLIC_TESTING
 #include <Rose/BinaryAnalysis/Concolic/BasicTypes.h>
 
+#include <Rose/Yaml.h>
+
 #include <boost/filesystem.hpp>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/SharedPointer.h>
@@ -121,6 +123,12 @@ public:
      *  pointer. */
     virtual ConcreteResultPtr execute(const TestCasePtr&) = 0;
 
+    /** Configure the executor.
+     *
+     *  The execution manager calls this with its YAML configuration after creating the executor and before running any test
+     *  cases. Subclasses can use it to read settings that are specific to them. The default implementation does nothing. */
+    virtual void configure(const Yaml::Node&);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Old stuff
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -353,6 +353,26 @@ public:
      *  null pointer is returned. */
     ConcreteResultPtr readConcreteResult(TestCaseId);
 
+    /** Record statistics about one concrete run.
+     *
+     *  Concrete executors call this each time they run a test case. The @p startupTime is the number of seconds it took to
+     *  obtain a process that's ready to run the test case. The @p snapshotReuses is the number of times the process snapshot
+     *  from which this run was forked had already been used by earlier runs, or nothing if the run didn't start from a
+     *  snapshot. */
+    void saveConcreteRun(TestCaseId, const std::string &executorName, double startupTime,
+                         const Sawyer::Optional<size_t> &snapshotReuses);
+
+    /** Summary of concrete run statistics. */
+    struct ConcreteRunSummary {
+        size_t nRuns = 0;                               /**< Number of runs recorded. */
+        double totalStartupTime = 0.0;                  /**< Total startup time for all runs in seconds. */
+        size_t nSnapshotRuns = 0;                       /**< Number of runs that started from a snapshot. */
+        size_t nSnapshotReuses = 0;                     /**< Number of runs that reused a snapshot created by an earlier run. */
+    };
+
+    /** Summarize the concrete run statistics for all test cases. */
+    ConcreteRunSummary concreteRunSummary();
+
    /** Returns @p n test cases without concrete results.
     *
     * Thread safety: thread safe
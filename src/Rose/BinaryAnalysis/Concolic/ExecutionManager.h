@@ -69,6 +69,11 @@ public:
      *  @li "concolic-stride" is an optional positive integer that indicates the maximum number of test cases that are run
      *  concolically at a time, before running any pending concrete tests. The default is one.
      *
+     *  @li "fork-server" optionally enables snapshot execution for architectures and executors that support it. Instead of
+     *  starting the specimen from scratch for each test case, the specimen is run once up to a snapshot point and each test case
+     *  runs in a fork of that stopped process. The value is "no" (the default), "entry", "first-read", or an address at which
+     *  to take the snapshot. Concolic execution always snapshots at the entry point. See @ref I386Linux::ForkServer.
+     *
      *  A reference to the YAML configuration tree is stored in the returned object. The existing database is opened and will
      *  be closed by the destructor. A particular test suite within the database is active. */
     static Ptr instance(const ConcolicExecutorSettings&, const Yaml::Node&);
@@ -5,6 +5,7 @@
 #include <Rose/BinaryAnalysis/Concolic/I386Linux/BasicTypes.h>
 #include <Rose/BinaryAnalysis/Concolic/I386Linux/ExitStatusExecutor.h>
 #include <Rose/BinaryAnalysis/Concolic/I386Linux/ExitStatusResult.h>
+#include <Rose/BinaryAnalysis/Concolic/I386Linux/ForkServer.h>
 #include <Rose/BinaryAnalysis/Concolic/I386Linux/TracingExecutor.h>
 #include <Rose/BinaryAnalysis/Concolic/I386Linux/TracingResult.h>
 
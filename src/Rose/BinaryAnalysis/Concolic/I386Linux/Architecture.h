@@ -32,6 +32,7 @@ public:
 private:
     bool markingArgvAsInput_ = true;
     bool markingEnvpAsInput_ = false;
+    bool usingForkServer_ = false;                      // fork processes from an entry point snapshot instead of exec'ing
 
 protected:
     Architecture(const std::string&);                   // for instantiating a factory
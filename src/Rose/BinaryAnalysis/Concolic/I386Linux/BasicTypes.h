@@ -22,6 +22,9 @@ using ExitStatusManagerPtr = Sawyer::SharedPointer<ExitStatusManager>;
 class ExitStatusResult;
 using ExitStatusResultPtr = Sawyer::SharedPointer<ExitStatusResult>;
 
+class ForkServer;
+using ForkServerPtr = Sawyer::SharedPointer<ForkServer>;
+
 class TracingExecutor;
 using TracingExecutorPtr = Sawyer::SharedPointer<TracingExecutor>;
 
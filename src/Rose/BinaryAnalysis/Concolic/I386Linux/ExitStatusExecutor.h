@@ -9,6 +9,7 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <Rose/BinaryAnalysis/Concolic/ConcreteExecutor.h>
+#include <Rose/BinaryAnalysis/Concolic/I386Linux/ForkServer.h>
 #include <Sawyer/Optional.h>
 #include <Sawyer/SharedPointer.h>
 #include <string>
@@ -33,6 +34,9 @@ public:
 
 protected:
     bool useAddressRandomization_ = false;              // enable/disable address space randomization in the OS
+    bool usingForkServer_ = false;                      // run test cases in processes forked from a snapshot
+    ForkServer::SnapshotPoint snapshotPoint_ = ForkServer::SnapshotPoint::FIRST_READ; // where to take the snapshot
+    rose_addr_t snapshotVa_ = 0;                        // snapshot address if snapshotPoint_ is ADDRESS
 
 protected:
     explicit ExitStatusExecutor(const std::string &name); // for creating a factory
@@ -57,10 +61,38 @@ public:
     void useAddressRandomization(bool b) { useAddressRandomization_ = b; }
     /** @} */
 
+    /** Property: Whether to use a fork server.
+     *
+     *  When set, each test case runs in a process forked from a snapshot of the specimen instead of a process that's started
+     *  from scratch. See @ref ForkServer. The startup time and snapshot reuse count for each run are saved in the database.
+     *  The fork server is not used when there is an execution monitor. This is off by default, and is copied from the factory
+     *  when an executor is created by a factory.
+     *
+     * @{ */
+    bool usingForkServer() const { return usingForkServer_; }
+    void usingForkServer(bool b) { usingForkServer_ = b; }
+    /** @} */
+
+    /** Property: Fork server snapshot point.
+     *
+     *  Where the fork server takes its snapshot, and the snapshot address if the snapshot point is @c ADDRESS.
+     *
+     * @{ */
+    ForkServer::SnapshotPoint snapshotPoint() const { return snapshotPoint_; }
+    void snapshotPoint(ForkServer::SnapshotPoint p) { snapshotPoint_ = p; }
+    rose_addr_t snapshotVa() const { return snapshotVa_; }
+    void snapshotVa(rose_addr_t va) { snapshotVa_ = va; }
+    /** @} */
+
 public:
     virtual bool matchFactory(const std::string&) const override;
     virtual Concolic::ConcreteExecutorPtr instanceFromFactory(const DatabasePtr&) override;
     virtual Concolic::ConcreteResultPtr execute(const TestCasePtr&) override;
+    virtual void configure(const Yaml::Node&) override;
+
+private:
+    // Run a test case in a process forked from a snapshot. Returns the exit status as documented for waitpid.
+    int executeForked(const TestCasePtr&, const boost::filesystem::path &logout, const boost::filesystem::path &logerr);
 };
 
 } // namespace
@@ -0,0 +1,147 @@
+#ifndef ROSE_BinaryAnalysis_Concolic_I386Linux_ForkServer_H
+#define ROSE_BinaryAnalysis_Concolic_I386Linux_ForkServer_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_CONCOLIC_TESTING
+#include <Rose/BinaryAnalysis/Concolic/BasicTypes.h>
+
+#include <Rose/BinaryAnalysis/Concolic/TestCase.h>
+#include <Rose/BinaryAnalysis/Debugger/BasicTypes.h>
+
+#include <Rose/Yaml.h>
+
+#include <boost/filesystem.hpp>
+#include <Sawyer/FileSystem.h>
+#include <Sawyer/SharedObject.h>
+#include <Sawyer/SharedPointer.h>
+#include <string>
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace Concolic {
+namespace I386Linux {
+
+/** Snapshot of a specimen process from which test case processes are forked.
+ *
+ *  Starting a specimen from scratch for each test case (writing the executable to a file, forking, executing, and letting the
+ *  specimen initialize itself) is a large part of the cost of running short test cases. A fork server instead runs the specimen
+ *  once under a @ref Debugger::Linux up to a snapshot point and keeps that stopped process as a template. Each test case then
+ *  obtains its own process by forking the template, which is much cheaper than starting over.
+ *
+ *  A snapshot can only be shared by test cases whose processes would have been identical up to the snapshot point. Therefore
+ *  servers are keyed by specimen, command-line arguments, and environment, and @ref instance returns the same server for the
+ *  same key.
+ *
+ *  The template runs in the server's temporary directory, which also holds the executable, and @ref fork moves each new
+ *  process to the working directory it would have had if it had been started from scratch. Therefore only relative file names
+ *  that the specimen uses before the snapshot point refer to the server's directory. Processes forked from the template share
+ *  open file descriptions with it. The template is started with its standard input and outputs redirected to "/dev/null" and
+ *  all other files closed, so this is only an issue for files that the specimen opens before the snapshot point.
+ *
+ *  The template ignores @c SIGCHLD so that the processes forked from it don't remain as zombies after they exit. Each forked
+ *  process gets the specimen's original @c SIGCHLD action back.
+ *
+ *  Thread safety: Processes are traced by the thread that created them, so a server must be used only by the thread that
+ *  created it. The @ref instance method keeps a separate set of servers for each thread. */
+class ForkServer: public Sawyer::SharedObject {
+public:
+    /** Reference counting pointer. */
+    using Ptr = ForkServerPtr;
+
+    /** Where to take the snapshot. */
+    enum class SnapshotPoint {
+        ENTRY,                                          /**< Immediately after the executable is loaded. */
+        FIRST_READ,                                     /**< Just before the first @c read system call. */
+        ADDRESS                                         /**< The first time execution reaches the snapshot address. */
+    };
+
+    /** Settings that affect the template process. */
+    struct Settings {
+        std::vector<std::string> arguments;             /**< Command-line arguments, not including the program name. */
+        std::vector<EnvValue> environment;              /**< Environment variables. */
+        bool inheritEnvironment = false;                /**< Start with this process's environment rather than an empty one. */
+        bool randomizedAddresses = false;               /**< Whether the OS should randomize the address space. */
+        SnapshotPoint snapshotPoint = SnapshotPoint::FIRST_READ; /**< Where to take the snapshot. */
+        rose_addr_t snapshotVa = 0;                     /**< Snapshot address when @c snapshotPoint is @c ADDRESS. */
+        bool recordingExecutedVas = false;              /**< Single step to the snapshot point to record executed addresses. */
+
+        bool operator==(const Settings&) const;
+    };
+
+private:
+    SpecimenPtr specimen_;                              // specimen from which the template was created
+    Settings settings_;                                 // settings used to create the template
+    Sawyer::FileSystem::TemporaryDirectory tmpDir_;     // holds the executable for the lifetime of the template
+    boost::filesystem::path exeName_;                   // executable within tmpDir_
+    Debugger::LinuxPtr template_;                       // stopped process from which new processes are forked
+    SnapshotPoint snapshotPoint_ = SnapshotPoint::ENTRY; // where the snapshot was actually taken
+    double creationTime_ = 0.0;                         // seconds to create the template
+    AddressSet executedVas_;                            // addresses executed before the snapshot, if recorded
+    size_t nForks_ = 0;                                 // number of processes forked from the template
+    std::vector<uint8_t> sigchldAction_;                // specimen's SIGCHLD action, replaced by SIG_IGN in the template
+
+protected:
+    ForkServer(const SpecimenPtr&, const Settings&);
+
+public:
+    ~ForkServer();
+
+    /** Obtain a server for a specimen.
+     *
+     *  Returns the calling thread's existing server for the specified specimen and settings, or creates a new one. Throws an
+     *  @ref Exception if the template process cannot be created. Only the few most recently used servers of each thread are
+     *  kept; the others are discarded as if by @ref clearInstances. */
+    static Ptr instance(const SpecimenPtr&, const Settings&);
+
+    /** Parse the "fork-server" configuration.
+     *
+     *  Looks for a "fork-server" key in the specified YAML map. Its value is "no" (the default), "entry", "first-read", or an
+     *  address, and corresponds to the @ref SnapshotPoint values. Returns true and adjusts the snapshot point in @p settings if
+     *  a fork server is requested. Throws an @ref Exception if the value is not valid. */
+    static bool parseConfig(const Yaml::Node&, Settings&);
+
+    /** Discard the calling thread's servers.
+     *
+     *  The template processes are killed when the last reference to their servers is released. This is called when @ref
+     *  ExecutionManager::run finishes. */
+    static void clearInstances();
+
+    /** Settings used to create the template. */
+    const Settings& settings() const;
+
+    /** Where the snapshot was actually taken.
+     *
+     *  If the specimen terminates before reaching the requested snapshot point, or the snapshot point is not one at which the
+     *  specimen can be stopped, then the snapshot is taken at the specimen's entry point instead. */
+    SnapshotPoint snapshotPoint() const;
+
+    /** Number of seconds it took to create the template process. */
+    double creationTime() const;
+
+    /** Addresses executed before the snapshot point.
+     *
+     *  This is empty unless the settings requested that executed addresses be recorded. The instruction at the snapshot point
+     *  has not been executed yet, and is therefore not included. */
+    const AddressSet& executedVas() const;
+
+    /** Number of processes forked so far. */
+    size_t nForks() const;
+
+    /** Fork a new process from the template.
+     *
+     *  Returns a debugger attached to the new process, which is stopped at the snapshot point. If @p workingDirectory is not
+     *  empty then the new process changes to that directory before it's returned. Throws an @ref Exception if the process
+     *  cannot be created or set up. */
+    Debugger::LinuxPtr fork(const boost::filesystem::path &workingDirectory);
+
+private:
+    bool createTemplate(SnapshotPoint);
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
+#endif
@@ -5,6 +5,7 @@
 #include <Rose/BinaryAnalysis/Concolic/BasicTypes.h>
 
 #include <Rose/BinaryAnalysis/Concolic/ConcreteExecutor.h>
+#include <Rose/BinaryAnalysis/Concolic/I386Linux/ForkServer.h>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/SharedPointer.h>
 
@@ -25,6 +26,10 @@ public:
 
 
 private:
+    bool usingForkServer_ = false;                      // run test cases in processes forked from a snapshot
+    ForkServer::SnapshotPoint snapshotPoint_ = ForkServer::SnapshotPoint::FIRST_READ; // where to take the snapshot
+    rose_addr_t snapshotVa_ = 0;                        // snapshot address if snapshotPoint_ is ADDRESS
+
     friend class boost::serialization::access;
 
     template<class S>
@@ -44,6 +49,28 @@ public:
     /** Factory constructor. */
     static Ptr factory();
 
+    /** Property: Whether to use a fork server.
+     *
+     *  When set, each test case runs in a process forked from a snapshot of the specimen instead of a process that's started
+     *  from scratch. See @ref ForkServer. The startup time and snapshot reuse count for each run are saved in the database.
+     *  This is off by default, and is copied from the factory when an executor is created by a factory.
+     *
+     * @{ */
+    bool usingForkServer() const { return usingForkServer_; }
+    void usingForkServer(bool b) { usingForkServer_ = b; }
+    /** @} */
+
+    /** Property: Fork server snapshot point.
+     *
+     *  Where the fork server takes its snapshot, and the snapshot address if the snapshot point is @c ADDRESS.
+     *
+     * @{ */
+    ForkServer::SnapshotPoint snapshotPoint() const { return snapshotPoint_; }
+    void snapshotPoint(ForkServer::SnapshotPoint p) { snapshotPoint_ = p; }
+    rose_addr_t snapshotVa() const { return snapshotVa_; }
+    void snapshotVa(rose_addr_t va) { snapshotVa_ = va; }
+    /** @} */
+
     /** Specimen exit status, as returned by wait. */
     static int exitStatus(const ConcreteResultPtr&);
 
@@ -55,6 +82,7 @@ public:
     // Documented in super class
     virtual bool matchFactory(const std::string&) const override;
     virtual Concolic::ConcreteExecutorPtr instanceFromFactory(const DatabasePtr&) override;
+    virtual void configure(const Yaml::Node&) override;
 };
 
 } // namespace
@@ -9,11 +9,15 @@
 #include <Rose/BinaryAnalysis/InstructionSemantics/SymbolicSemantics.h>
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <list>
 #include <Sawyer/GraphTraversal.h>
 #include <Sawyer/DistinctList.h>
+#include <set>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Rose {
@@ -105,6 +109,51 @@ public:
         explicit NotConverging(const std::string &s): Exception(s) {}
     };
 
+    /** Order in which a data-flow engine visits vertices.
+     *
+     *  The @ref Engine keeps a work list of vertices whose incoming states have changed and which therefore need to be visited
+     *  again. This setting determines which vertex is removed from the work list next. The orders other than @c FIFO are
+     *  computed from the control flow graph the first time a vertex is added to the work list after the engine is reset, and
+     *  the vertices are then visited in priority order, which generally stabilizes inner loops before their results are
+     *  propagated further. */
+    enum class WorkListOrder {
+        FIFO,                                           /**< Visit vertices in the order they were added to the work list. */
+        REVERSE_POSTORDER,                              /**< Visit the pending vertex that is earliest in reverse postorder. Loop
+                                                         *   heads are the targets of retreating edges in the depth-first
+                                                         *   search. */
+        WEAK_TOPOLOGICAL                                /**< Visit the pending vertex that is earliest in Bourdoncle's weak
+                                                         *   topological order. Loop heads are the heads of the order's
+                                                         *   components. */
+    };
+
+    /** Counters for a data-flow engine.
+     *
+     *  These are reset whenever the engine is reset, and are useful for comparing the work done by the various @ref
+     *  WorkListOrder settings. */
+    struct EngineStatistics {
+        size_t nVisits = 0;                             /**< Number of times the transfer function was called. */
+        size_t nMerges = 0;                             /**< Number of states merged into incoming states, including widening. */
+        size_t nMergeChanges = 0;                       /**< Number of merges that changed the incoming state. */
+        size_t nWidenings = 0;                          /**< Number of merges that were performed by widening. */
+        size_t nWideningPoints = 0;                     /**< Number of loop heads at which widening can occur. */
+
+        /** Print the counters, one per line. */
+        void print(std::ostream&, const std::string &prefix = "") const;
+    };
+
+private:
+    // Whether a merge function has a "widen" member function that takes the same arguments as its function operator.
+    template<class MergeFunction, class State>
+    class HasWiden {
+        template<class M>
+        static auto test(int) -> decltype(std::declval<M&>().widen(std::declval<State&>(), std::declval<const State&>()),
+                                          std::true_type());
+        template<class M>
+        static std::false_type test(...);
+    public:
+        static constexpr bool value = decltype(test<MergeFunction>(0))::value;
+    };
+
 private:
     InstructionSemantics::BaseSemantics::RiscOperatorsPtr userOps_;   // operators (and state) provided by the user
     InstructionSemantics::DataFlowSemantics::RiscOperatorsPtr dfOps_; // data-flow operators (which point to user ops)
@@ -291,7 +340,11 @@ public:
      *      changed, false if there was no change. In order for a data-flow to reach a fixed point the values must form a
      *      lattice and a merge operation should return a value which is the greatest lower bound. This implies that the
      *      lattice has a bottom element that is a descendent of all other vertices.  However, the data-flow engine is designed
-     *      to also operate in cases where a fixed point cannot be reached.
+     *      to also operate in cases where a fixed point cannot be reached. The MergeFunction may optionally also have a @c
+     *      widen member function that takes the same arguments and returns the same value, in which case it is called instead
+     *      of the function operator when merging into a loop head that has already been visited at least @ref
+     *      Engine::wideningDelay "wideningDelay" times. Widening is applied only at loop heads, which are computed according
+     *      to the @ref WorkListOrder.
      *
      *  @li @p PathFeasibility is a predicate that returns true if the data-flow should traverse the specified CFG edge.  It's
      *      called with the following arguments: (1) the CFG, which it should accept as a const reference argument for
@@ -306,7 +359,10 @@ public:
      *  InstructionSemantics::BaseSemantics::State::merge "merge" method.
      *
      *  The control flow graph and transfer function are specified in the engine's constructor.  The starting CFG vertex and
-     *  its initial state are supplied when the engine starts to run. */
+     *  its initial state are supplied when the engine starts to run.
+     *
+     *  The order in which vertices are visited is controlled by the @ref workListOrder property, and the amount of work
+     *  performed since the last reset is available from @ref statistics. */
     template<class Cfg_, class State_, class TransferFunction_, class MergeFunction_,
              class PathFeasibility_ = PathAlwaysFeasible<Cfg_, State_> >
     class Engine {
@@ -328,11 +384,20 @@ public:
         VertexStates incomingState_;                    // incoming data-flow state per CFG vertex ID
         VertexStates outgoingState_;                    // outgoing data-flow state per CFG vertex ID
         typedef Sawyer::Container::DistinctList<size_t> WorkList;
-        WorkList workList_;                             // CFG vertex IDs to be visited, last in first out w/out duplicates
+        WorkList workList_;                             // CFG vertex IDs to be visited, first in first out w/out duplicates
         size_t maxIterations_;                          // max number of iterations to allow
         size_t nIterations_;                            // number of iterations since last reset
         PathFeasibility isFeasible_;                    // predicate to test path feasibility
 
+        WorkListOrder workListOrder_ = WorkListOrder::FIFO; // how to choose the next vertex to visit
+        std::set<size_t> orderedWorkList_;              // positions in schedule_ of vertices to be visited for non-FIFO orders
+        std::vector<size_t> schedule_;                  // vertex IDs in priority order; empty if not computed yet
+        std::vector<size_t> position_;                  // position of each vertex ID in schedule_
+        std::vector<bool> isLoopHead_;                  // vertices at which widening may occur, indexed by vertex ID
+        std::vector<size_t> nVisits_;                   // number of visits per vertex ID since last reset
+        size_t wideningDelay_ = 1;                      // number of visits to a loop head before widening is used
+        EngineStatistics stats_;                        // counters since last reset
+
     public:
         /** Constructor.
          *
@@ -361,7 +426,14 @@ public:
             outgoingState_.clear();
             outgoingState_.resize(cfg_.nVertices(), initialState);
             workList_.clear();
+            orderedWorkList_.clear();
+            schedule_.clear();
+            position_.clear();
+            isLoopHead_.clear();
+            nVisits_.clear();
+            nVisits_.resize(cfg_.nVertices(), 0);
             nIterations_ = 0;
+            stats_ = EngineStatistics();
         }
 
         /** Property: Name for debugging.
@@ -396,6 +468,290 @@ public:
          *
          *  The number of times runOneIteration was called since the last reset. */
         size_t nIterations() const { return nIterations_; }
+
+        /** Property: Order in which vertices are visited.
+         *
+         *  The default is @c FIFO. Changing the order while the work list is not empty causes the pending vertices to be
+         *  reordered.
+         *
+         * @{ */
+        WorkListOrder workListOrder() const { return workListOrder_; }
+        void workListOrder(WorkListOrder order) {
+            const std::vector<size_t> pending = workListItems();
+            workList_.clear();
+            orderedWorkList_.clear();
+            schedule_.clear();
+            position_.clear();
+            isLoopHead_.clear();
+            workListOrder_ = order;
+            for (size_t id: pending)
+                pushWorkList(id);
+        }
+        /** @} */
+
+        /** Property: Number of visits to a loop head before widening.
+         *
+         *  If the merge function has a @c widen method, then it is used instead of the merge function when merging into the
+         *  incoming state of a loop head that has been visited at least this many times. The default is one, which means the
+         *  first merge into a loop head (usually from outside the loop) is a normal merge.
+         *
+         * @{ */
+        size_t wideningDelay() const { return wideningDelay_; }
+        void wideningDelay(size_t n) { wideningDelay_ = n; }
+        /** @} */
+
+        /** Counters since the last reset. */
+        const EngineStatistics& statistics() const { return stats_; }
+
+        /** Vertices waiting to be visited.
+         *
+         *  Returns the IDs of the vertices in the work list in the order they will be visited. */
+        std::vector<size_t> workListItems() const {
+            if (WorkListOrder::FIFO == workListOrder_) {
+                return std::vector<size_t>(workList_.items().begin(), workList_.items().end());
+            } else {
+                std::vector<size_t> retval;
+                retval.reserve(orderedWorkList_.size());
+                for (size_t position: orderedWorkList_)
+                    retval.push_back(schedule_[position]);
+                return retval;
+            }
+        }
+
+        /** Whether a vertex is a loop head.
+         *
+         *  Returns true if the specified vertex is a loop head according to the current @ref workListOrder. Loop heads are not
+         *  computed for the @c FIFO order unless the merge function has a @c widen method, and they're not computed until a
+         *  vertex is added to the work list. */
+        bool isLoopHead(size_t cfgVertexId) const {
+            return cfgVertexId < isLoopHead_.size() && isLoopHead_[cfgVertexId];
+        }
+
+    private:
+        bool isWorkListEmpty() const {
+            return WorkListOrder::FIFO == workListOrder_ ? workList_.isEmpty() : orderedWorkList_.empty();
+        }
+
+        size_t popWorkList() {
+            if (WorkListOrder::FIFO == workListOrder_) {
+                return workList_.popFront();
+            } else {
+                ASSERT_forbid(orderedWorkList_.empty());
+                const size_t position = *orderedWorkList_.begin();
+                orderedWorkList_.erase(orderedWorkList_.begin());
+                return schedule_[position];
+            }
+        }
+
+        void pushWorkList(size_t cfgVertexId) {
+            ASSERT_require(cfgVertexId < cfg_.nVertices());
+            if (schedule_.empty() && (WorkListOrder::FIFO != workListOrder_ || HasWiden<MergeFunction, State>::value))
+                computeSchedule(cfgVertexId);
+            if (WorkListOrder::FIFO == workListOrder_) {
+                workList_.pushBack(cfgVertexId);
+            } else {
+                orderedWorkList_.insert(position_[cfgVertexId]);
+            }
+        }
+
+        // Compute the priority order and loop heads for all vertices. The specified vertex is the first root and the remaining
+        // roots are the vertices that have no incoming edges and then any vertices that are still unreached, in ID order.
+        void computeSchedule(size_t firstRoot) {
+            const size_t nVertices = cfg_.nVertices();
+            schedule_.clear();
+            schedule_.reserve(nVertices);
+            isLoopHead_.clear();
+            isLoopHead_.resize(nVertices, false);
+
+            std::vector<size_t> roots;
+            roots.reserve(2 * nVertices + 1);
+            roots.push_back(firstRoot);
+            for (size_t i = 0; i < nVertices; ++i) {
+                if (0 == cfg_.findVertex(i)->nInEdges())
+                    roots.push_back(i);
+            }
+            for (size_t i = 0; i < nVertices; ++i)
+                roots.push_back(i);
+
+            if (WorkListOrder::WEAK_TOPOLOGICAL == workListOrder_) {
+                computeWeakTopologicalOrder(roots);
+            } else {
+                computeReversePostorder(roots);
+            }
+            ASSERT_require(schedule_.size() == nVertices);
+
+            position_.clear();
+            position_.resize(nVertices, 0);
+            for (size_t i = 0; i < nVertices; ++i)
+                position_[schedule_[i]] = i;
+            stats_.nWideningPoints = std::count(isLoopHead_.begin(), isLoopHead_.end(), true);
+        }
+
+        // Reverse postorder by iterative depth-first search. Loop heads are the targets of retreating edges.
+        void computeReversePostorder(const std::vector<size_t> &roots) {
+            enum { UNSEEN = 0, ON_STACK, DONE };
+            std::vector<unsigned char> status(cfg_.nVertices(), UNSEEN);
+            struct Frame {
+                size_t id;
+                typename Cfg::ConstEdgeIterator next, end;
+            };
+            std::vector<Frame> stack;
+            std::vector<size_t> postorder;
+
+            for (size_t root: roots) {
+                if (status[root] != UNSEEN)
+                    continue;
+                postorder.clear();
+                status[root] = ON_STACK;
+                typename Cfg::ConstVertexIterator rootVertex = cfg_.findVertex(root);
+                stack.push_back(Frame{root, rootVertex->outEdges().begin(), rootVertex->outEdges().end()});
+                while (!stack.empty()) {
+                    Frame &frame = stack.back();
+                    if (frame.next == frame.end) {
+                        status[frame.id] = DONE;
+                        postorder.push_back(frame.id);
+                        stack.pop_back();
+                    } else {
+                        typename Cfg::ConstVertexIterator target = frame.next->target();
+                        ++frame.next;
+                        if (UNSEEN == status[target->id()]) {
+                            status[target->id()] = ON_STACK;
+                            stack.push_back(Frame{target->id(), target->outEdges().begin(), target->outEdges().end()});
+                        } else if (ON_STACK == status[target->id()]) {
+                            isLoopHead_[target->id()] = true;
+                        }
+                    }
+                }
+                schedule_.insert(schedule_.end(), postorder.rbegin(), postorder.rend());
+            }
+        }
+
+        // One activation of Bourdoncle's visit or component function, for computing a weak topological order without recursion.
+        struct WtoFrame {
+            size_t id;
+            typename Cfg::ConstEdgeIterator next, end;  // successors not yet processed
+            size_t head;                                // smallest depth-first number reached so far (visit only)
+            bool isLoop;                                // whether a successor reached this vertex or above (visit only)
+            bool isComponent;                           // component of the head "id" rather than a visit of "id"
+        };
+
+        // State for computing a weak topological order.
+        struct Wto {
+            std::vector<size_t> dfn;                    // depth-first number, zero if unvisited, SIZE_MAX if finished
+            std::vector<size_t> stack;                  // vertices whose component isn't known yet
+            std::vector<size_t> reversed;               // the order being built, in reverse
+            std::vector<WtoFrame> frames;               // explicit call stack replacing the recursion
+            size_t num = 0;                             // last depth-first number assigned
+        };
+
+        // Weak topological order by Bourdoncle's algorithm ("Efficient chaotic iteration strategies with widenings", 1993),
+        // with the recursion replaced by an explicit stack as in computeReversePostorder. The order is flattened, so the head of
+        // each component immediately precedes the component's body.
+        void computeWeakTopologicalOrder(const std::vector<size_t> &roots) {
+            Wto wto;
+            wto.dfn.resize(cfg_.nVertices(), 0);
+            for (size_t root: roots) {
+                if (0 == wto.dfn[root]) {
+                    wto.reversed.clear();
+                    wtoVisit(root, wto);
+                    schedule_.insert(schedule_.end(), wto.reversed.rbegin(), wto.reversed.rend());
+                }
+            }
+        }
+
+        void wtoPushVisit(size_t vertexId, Wto &wto) {
+            wto.stack.push_back(vertexId);
+            wto.dfn[vertexId] = ++wto.num;
+            typename Cfg::ConstVertexIterator vertex = cfg_.findVertex(vertexId);
+            wto.frames.push_back(WtoFrame{vertexId, vertex->outEdges().begin(), vertex->outEdges().end(), wto.dfn[vertexId],
+                                          false, false});
+        }
+
+        void wtoVisit(size_t rootId, Wto &wto) {
+            wtoPushVisit(rootId, wto);
+            bool hasReturned = false;
+            size_t returned = 0;                        // value returned by the visit that just finished
+            while (!wto.frames.empty()) {
+                WtoFrame &frame = wto.frames.back();
+                if (hasReturned) {
+                    hasReturned = false;
+                    if (!frame.isComponent && returned <= frame.head) {
+                        frame.head = returned;
+                        frame.isLoop = true;
+                    }
+                }
+
+                if (frame.next != frame.end) {
+                    const size_t successorId = frame.next->target()->id();
+                    ++frame.next;
+                    if (0 == wto.dfn[successorId]) {
+                        wtoPushVisit(successorId, wto);     // invalidates "frame"
+                    } else if (!frame.isComponent && wto.dfn[successorId] <= frame.head) {
+                        frame.head = wto.dfn[successorId];
+                        frame.isLoop = true;
+                    }
+                    continue;
+                }
+
+                if (frame.isComponent) {
+                    wto.reversed.push_back(frame.id);
+                    isLoopHead_[frame.id] = true;
+                } else if (frame.head == wto.dfn[frame.id]) {
+                    wto.dfn[frame.id] = (size_t)(-1);
+                    size_t element = wto.stack.back();
+                    wto.stack.pop_back();
+                    if (frame.isLoop) {
+                        while (element != frame.id) {
+                            wto.dfn[element] = 0;
+                            element = wto.stack.back();
+                            wto.stack.pop_back();
+                        }
+
+                        // The visit continues as the component of this head, and returns its head when that finishes.
+                        typename Cfg::ConstVertexIterator vertex = cfg_.findVertex(frame.id);
+                        frame.next = vertex->outEdges().begin();
+                        frame.end = vertex->outEdges().end();
+                        frame.isComponent = true;
+                        continue;
+                    } else {
+                        wto.reversed.push_back(frame.id);
+                    }
+                }
+
+                returned = frame.head;
+                hasReturned = true;
+                wto.frames.pop_back();
+            }
+        }
+
+        // Merge an outgoing state into the incoming state of the specified vertex, widening if appropriate. Returns true if the
+        // incoming state changed.
+        bool mergeInto(size_t cfgVertexId, const State &state) {
+            const bool useWidening = HasWiden<MergeFunction, State>::value && isLoopHead(cfgVertexId) &&
+                                     nVisits_[cfgVertexId] >= wideningDelay_;
+            ++stats_.nMerges;
+            bool changed = false;
+            if (useWidening) {
+                ++stats_.nWidenings;
+                changed = widen(incomingState_[cfgVertexId], state,
+                                std::integral_constant<bool, HasWiden<MergeFunction, State>::value>());
+            } else {
+                changed = merge_(incomingState_[cfgVertexId], state);
+            }
+            if (changed)
+                ++stats_.nMergeChanges;
+            return changed;
+        }
+
+        bool widen(State &dst, const State &src, std::true_type) {
+            return merge_.widen(dst, src);
+        }
+
+        bool widen(State &dst, const State &src, std::false_type) {
+            return merge_(dst, src);
+        }
+
+    public:
         
         /** Runs one iteration.
          *
@@ -403,16 +759,16 @@ public:
          *  work list is empty (before of after the iteration). */
         bool runOneIteration() {
             using namespace Diagnostics;
-            if (!workList_.isEmpty()) {
+            if (!isWorkListEmpty()) {
                 if (++nIterations_ > maxIterations_) {
                     throw NotConverging("data-flow max iterations reached"
                                         " (max=" + StringUtility::numberToString(maxIterations_) + ")");
                 }
-                size_t cfgVertexId = workList_.popFront();
+                size_t cfgVertexId = popWorkList();
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<prefix() <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
                     mlog[DEBUG] <<prefix() <<"  remaining worklist is {";
-                    for (size_t id: workList_.items())
+                    for (size_t id: workListItems())
                         mlog[DEBUG] <<" " <<id;
                     mlog[DEBUG] <<" }\n";
                 }
@@ -427,6 +783,8 @@ public:
                 }
 
                 state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, state);
+                ++nVisits_[cfgVertexId];
+                ++stats_.nVisits;
                 if (mlog[DEBUG]) {
                     mlog[DEBUG] <<prefix() <<"  outgoing state for vertex #" <<cfgVertexId <<":\n"
                                 <<StringUtility::prefixLines(xfer_.toString(state), prefix() + "    ") <<"\n";
@@ -441,26 +799,26 @@ public:
                     if (!isFeasible_(cfg_, edge, state, incomingState_[nextVertexId])) {
                         SAWYER_MESG(mlog[DEBUG]) <<prefix() <<"    path to vertex #" <<nextVertexId
                                                  <<" is not feasible, thus skipped\n";
-                    } else if (merge_(incomingState_[nextVertexId], state)) {
+                    } else if (mergeInto(nextVertexId, state)) {
                         if (mlog[DEBUG]) {
                             mlog[DEBUG] <<prefix() <<"    merged with vertex #" <<nextVertexId <<" (which changed as a result)\n";
                             mlog[DEBUG] <<prefix() <<"    merge state is:\n"
                                         <<StringUtility::prefixLines(xfer_.toString(incomingState_[nextVertexId]),
                                                                      prefix() + "      ", false) <<"\n";
                         }
-                        workList_.pushBack(nextVertexId);
+                        pushWorkList(nextVertexId);
                     } else {
                         SAWYER_MESG(mlog[DEBUG]) <<prefix() <<"    merged with vertex #" <<nextVertexId <<" (no change)\n";
                     }
                 }
             }
-            return !workList_.isEmpty();
+            return !isWorkListEmpty();
         }
 
         /** Add a starting vertex. */
         void insertStartingVertex(size_t startVertexId, const State &initialState) {
             incomingState_[startVertexId] = initialState;
-            workList_.pushBack(startVertexId);
+            pushWorkList(startVertexId);
         }
 
         /** Run data-flow until it reaches a fixed point.
@@ -5,8 +5,10 @@
 #include <Rose/BinaryAnalysis/Debugger/BasicTypes.h>
 
 #include <Rose/BinaryAnalysis/Debugger/ThreadId.h>
+#include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 
 #include <Sawyer/BitVector.h>
+#include <Sawyer/Map.h>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/Trace.h>
 
@@ -22,6 +24,12 @@ public:
     /** Shared ownership pointer. */
     using Ptr = Debugger::Ptr;
 
+    /** Instruction addresses of basic blocks.
+     *
+     *  Maps the starting address of each basic block to the addresses of the block's instructions in execution order. See
+     *  @ref blockInstructions. */
+    using BlockInstructions = Sawyer::Container::Map<rose_addr_t, std::vector<rose_addr_t>>;
+
 protected:
     Disassembler::BasePtr disassembler_;                // how to disassemble instructions
 
@@ -117,6 +125,13 @@ public:
     /** Run until the next breakpoint is reached. */
     virtual void runToBreakPoint(ThreadId) = 0;
 
+    /** Run until the specified address is reached.
+     *
+     *  A temporary break point is set at @p va, the subordinate is run until it stops there or terminates, and then the
+     *  break point is cleared (including any break point that the user might have set at that same address). At least one
+     *  instruction is executed. */
+    virtual void runToAddress(ThreadId, rose_addr_t va);
+
     /** Run the program and return an execution trace. */
     virtual Sawyer::Container::Trace<rose_addr_t> trace();
 
@@ -140,6 +155,58 @@ public:
         return retval;
     }
 
+    /** Index the basic blocks of a partitioner for block-granular tracing.
+     *
+     *  Returns the instruction addresses for each basic block in the partitioner's control flow graph, indexed by the address
+     *  of the block's first instruction. */
+    static BlockInstructions blockInstructions(const Partitioner2::PartitionerConstPtr&);
+
+    /** Run the program and return an execution trace, stopping only once per basic block.
+     *
+     *  This is like the single-stepping version of @ref trace except it uses the known basic blocks, @p blocks, to avoid
+     *  stopping the subordinate at every instruction. When execution reaches the start of a known block that has more than one
+     *  instruction, the block's instructions are appended to the trace (subject to the @p filter), the subordinate runs to the
+     *  block's last instruction using a temporary break point, and then that last instruction is single stepped so the
+     *  successor is known exactly. Code that is not the start of a known block is single stepped as usual. Therefore the
+     *  result is the same as single stepping as long as control does not leave a block in the middle, such as by a fault or
+     *  asynchronous signal handler (the handler is not traced and the whole block appears in the trace).
+     *
+     *  If the @p filter returns a stop action for an instruction in the middle of a block, then the subordinate is run to that
+     *  instruction before returning, just as if it had been single stepped. Break points set by the user before this call might
+     *  cause the subordinate to stop early within a block, which is handled, but might also be cleared by this call. */
+    template<class Filter>
+    Sawyer::Container::Trace<rose_addr_t> trace(ThreadId tid, const BlockInstructions &blocks, Filter &filter) {
+        Sawyer::Container::Trace<rose_addr_t> retval;
+        while (!isTerminated()) {
+            const rose_addr_t va = executionAddress(tid);
+            auto block = blocks.find(va);
+            if (block == blocks.nodes().end() || block->value().size() < 2) {
+                FilterAction action = filter(va);
+                if (action.isClear(FilterActionFlag::REJECT))
+                    retval.append(va);
+                if (action.isSet(FilterActionFlag::STOP))
+                    return retval;
+                singleStep(tid);
+            } else {
+                const std::vector<rose_addr_t> &insnVas = block->value();
+                for (size_t i = 0; i < insnVas.size(); ++i) {
+                    FilterAction action = filter(insnVas[i]);
+                    if (action.isClear(FilterActionFlag::REJECT))
+                        retval.append(insnVas[i]);
+                    if (action.isSet(FilterActionFlag::STOP)) {
+                        if (i > 0)
+                            runToAddress(tid, insnVas[i]);
+                        return retval;
+                    }
+                }
+                runToAddress(tid, insnVas.back());
+                if (!isTerminated())
+                    singleStep(tid);
+            }
+        }
+        return retval;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Registers
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,7 @@
 #include <Rose/BinaryAnalysis/Debugger/Base.h>
 #include <Rose/BinaryAnalysis/SystemCall.h>
 
+#include <Sawyer/Map.h>
 #include <Sawyer/Optional.h>
 #include <sys/ptrace.h>
 
@@ -208,6 +209,7 @@ private:
     DetachMode autoDetach_ = DetachMode::KILL;          // how to detach from the subordinate when deleting this debugger
     int wstat_ = -1;                                    // last status from waitpid
     AddressIntervalSet breakPoints_;                    // list of break point addresses
+    Sawyer::Container::Map<rose_addr_t, uint8_t> swBreakPoints_; // INT3 instructions we inserted, and the bytes they replaced
     int sendSignal_ = 0;                                // pending signal
     UserRegDefs userRegDefs_;                           // how registers map to user_regs_struct in <sys/user.h>
     UserRegDefs userFpRegDefs_;                         // how registers map to user_fpregs_struct in <sys/user.h>
@@ -246,6 +248,23 @@ public:
     void attach(const Specimen&, Sawyer::Optional<DetachMode> onDelete = Sawyer::Nothing());
     /** @} */
 
+    /** Fork the subordinate process.
+     *
+     *  The subordinate, which must be attached and stopped, is coerced into making a @c fork system call and the resulting
+     *  child process is returned as a new debugger that is attached to the child and stopped. Both processes have the same
+     *  registers and memory they had before this call (other than the child's process ID), and the child inherits the break
+     *  points and specimen description of this debugger. This is much faster than starting a new process from scratch, and is
+     *  therefore useful for running many similar processes from a common snapshot. Note that the two processes share open file
+     *  descriptions, including file offsets.
+     *
+     *  The subordinate is the parent of each child it forks, so a child that exits becomes a zombie and queues a @c SIGCHLD
+     *  for the subordinate. This call discards a pending @c SIGCHLD, but reaping the children is up to the caller, for
+     *  instance by having the subordinate ignore @c SIGCHLD.
+     *
+     *  The child process is traced by the calling thread, and the returned debugger is configured to kill the child when the
+     *  debugger is destroyed. Throws an @ref Exception if the fork fails. */
+    Ptr forkSubordinate(ThreadId);
+
     /** Process ID of attached process. */
     Sawyer::Optional<int> processId() const;
 
@@ -279,6 +298,16 @@ public:
      *  encountered a signal or terminated. Execution does not stop at break points. */
     void runToSystemCall(ThreadId);
 
+    /** Run until just before a particular system call.
+     *
+     *  The subordinate is run until it is about to execute the specified system call (i386 numbering). When this returns true,
+     *  the subordinate is stopped with its instruction pointer at the system call instruction and the system call has not yet
+     *  been executed, so that the next @ref singleStep or @ref runToBreakPoint will make the call. Returns false if the
+     *  subordinate terminated first. Only system calls made by an x86 "INT 0x80" instruction can be backed up this way; if the
+     *  requested system call is made some other way then an @ref Exception is thrown and the subordinate is left in an
+     *  unspecified state. Execution does not stop at break points. */
+    bool runBeforeSystemCall(ThreadId, int syscallNumber);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // System calls
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -374,6 +403,17 @@ private:
 
     // Load system call declarations from the appropriate header file
     void declareSystemCalls(size_t nBits);
+
+    // Software break points. When there are not too many break points and each is a single address, runToBreakPoint writes an
+    // INT3 instruction at each break point address and lets the subordinate run at full speed instead of single stepping it.
+    // Break points that span more than one address are not known to start at instruction boundaries, so their presence makes
+    // runToBreakPoint single step instead. Adjacent single-address break points merge into one interval and therefore also
+    // cause single stepping. The INT3 instructions stay in memory until the break point is cleared or the subordinate is
+    // resumed some other way, and they're hidden from memory reads and writes.
+    bool canUseSoftwareBreakPoints() const;
+    void insertSoftwareBreakPoint(rose_addr_t);
+    void insertSoftwareBreakPoints();
+    void removeSoftwareBreakPoints(const AddressInterval &where = AddressInterval::whole());
 };
 
 std::ostream& operator<<(std::ostream&, const Linux::Specimen&);
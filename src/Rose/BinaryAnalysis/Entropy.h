@@ -0,0 +1,225 @@
+#ifndef ROSE_BinaryAnalysis_Entropy_H
+#define ROSE_BinaryAnalysis_Entropy_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/MemoryMap.h>
+#include <Rose/Exception.h>
+
+#include <Sawyer/IntervalMap.h>
+#include <Sawyer/Message.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+
+/** Entropy of memory measured over a sliding window.
+ *
+ *  This analysis slides a window of fixed size across memory and computes the entropy of the symbols in the window at each
+ *  position. A symbol is one or more bytes interpreted as a big-endian integer. Entropy is normalized to the closed interval
+ *  zero to one by dividing by the maximum possible entropy for the symbol size, so that one means every possible symbol
+ *  occurs equally often in the window.
+ *
+ *  The counts for one and two byte symbols are stored in flat arrays, the counts for symbols up to eight bytes are stored in a
+ *  hash table by value, and wider symbols are counted by their bytes. The entropy is updated incrementally as symbols
+ *  enter and leave the window. Sliding the window therefore costs time proportional to the number of symbols by which it
+ *  moves rather than the size of the window. The contiguous parts of a memory map are divided into pieces that are processed
+ *  in parallel.
+ *
+ *  The windows at which entropy is measured are chosen as follows. Memory is divided into maximal contiguous mapped
+ *  intervals. Within each interval, the first window starts at the first address that satisfies the alignment, and each
+ *  subsequent window starts @ref Settings::translation symbols after the previous window. Only windows that lie entirely
+ *  within the contiguous interval are measured. */
+class Entropy {
+public:
+    /** Exceptions thrown by this analysis. */
+    class Exception: public Rose::Exception {
+    public:
+        Exception(const std::string &what): Rose::Exception(what) {}
+        ~Exception() throw () {}
+    };
+
+    /** Settings that control the analysis. */
+    struct Settings {
+        /** Number of bytes per symbol. Must be at least one. Symbols wider than eight bytes are slower to count. */
+        size_t symbolSize = 1;
+
+        /** Number of symbols in each window. */
+        size_t windowSize = 1024;
+
+        /** Number of symbols by which the window moves at each step. */
+        size_t translation = 1;
+
+        /** Alignment of the first window in each contiguous interval, in bytes. Zero means the same as the symbol size. */
+        rose_addr_t alignment = 0;
+
+        /** Windows whose entropy is below this value are classified as @ref LOW_ENTROPY. */
+        double lowThreshold = 0.25;
+
+        /** Windows whose entropy is at least this value are classified as @ref HIGH_ENTROPY. */
+        double highThreshold = 0.9;
+    };
+
+    /** Coarse classification of memory by entropy. */
+    enum Classification {
+        LOW_ENTROPY,                                    /**< Padding, zero-filled, or highly repetitive data. */
+        MEDIUM_ENTROPY,                                 /**< Typical of machine code, text, and structured data. */
+        HIGH_ENTROPY                                    /**< Typical of compressed or encrypted data. */
+    };
+
+    /** Memory intervals and their classifications. */
+    typedef Sawyer::Container::IntervalMap<AddressInterval, Classification> ClassifiedIntervals;
+
+    /** Entropy of the window that starts at an address. */
+    struct Sample {
+        rose_addr_t va;                                 /**< Starting address of the window. */
+        double entropy;                                 /**< Normalized entropy of the window. */
+
+        Sample()
+            : va(0), entropy(0.0) {}
+
+        Sample(rose_addr_t va, double entropy)
+            : va(va), entropy(entropy) {}
+    };
+
+    /** Function called for each sample. */
+    typedef std::function<void(const Sample&)> SampleCallback;
+
+    /** Symbol counts for a window.
+     *
+     *  This is the low-level part of the analysis, which can be used directly to measure entropy over data that isn't in a
+     *  memory map. Symbols are inserted and erased one at a time and the entropy is updated in constant time. Symbols can be
+     *  given by their bytes for any symbol size, or as integers when they're at most eight bytes. */
+    class Window {
+        size_t symbolSize_;                             // bytes per symbol
+        std::vector<size_t> counts_;                    // symbol counts for one and two byte symbols
+        std::unordered_map<uint64_t, size_t> sparseCounts_; // symbol counts for three to eight byte symbols
+        std::unordered_map<std::string, size_t> wideCounts_; // symbol counts by bytes for symbols wider than eight bytes
+        size_t nSymbols_;                               // number of symbols in the window
+        double sumNLogN_;                               // sum of n*log(n) over the symbol counts
+        size_t nUpdates_;                               // updates since sumNLogN_ was last recomputed
+
+    public:
+        /** Construct an empty window for symbols of the specified size. */
+        explicit Window(size_t symbolSize);
+
+        /** Property: Number of bytes per symbol. */
+        size_t symbolSize() const { return symbolSize_; }
+
+        /** Number of symbols in the window. */
+        size_t nSymbols() const { return nSymbols_; }
+
+        /** Remove all symbols. */
+        void clear();
+
+        /** Symbol whose bytes are stored at the specified location.
+         *
+         *  The symbol size must be at most eight bytes. */
+        uint64_t symbol(const uint8_t*) const;
+
+        /** Insert a symbol, or its bytes.
+         *
+         *  The integer version requires a symbol size of at most eight bytes.
+         *
+         * @{ */
+        void insert(uint64_t symbol);
+        void insert(const uint8_t *bytes);
+        /** @} */
+
+        /** Erase a symbol, or its bytes.
+         *
+         *  The symbol must be present in the window. The integer version requires a symbol size of at most eight bytes.
+         *
+         * @{ */
+        void erase(uint64_t symbol);
+        void erase(const uint8_t *bytes);
+        /** @} */
+
+        /** Number of times a symbol occurs in the window.
+         *
+         *  The integer version requires a symbol size of at most eight bytes.
+         *
+         * @{ */
+        size_t count(uint64_t symbol) const;
+        size_t count(const uint8_t *bytes) const;
+        /** @} */
+
+        /** Call a function for each distinct symbol in the window and its count.
+         *
+         *  The integer version requires a symbol size of at most eight bytes. The other version works for all symbol sizes and
+         *  passes the symbol's @ref symbolSize bytes, which are valid only during the call.
+         *
+         * @{ */
+        void forEachSymbol(const std::function<void(uint64_t symbol, size_t count)>&) const;
+        void forEachSymbol(const std::function<void(const uint8_t *bytes, size_t count)>&) const;
+        /** @} */
+
+        /** Normalized entropy of the window.
+         *
+         *  The window must not be empty. */
+        double entropy() const;
+
+    private:
+        void update(size_t oldCount, size_t newCount);
+        void recompute();
+    };
+
+public:
+    /** Diagnostic facility. */
+    static Sawyer::Message::Facility mlog;
+
+private:
+    Settings settings_;
+
+public:
+    /** Construct an analysis with default settings. */
+    Entropy() {}
+
+    /** Construct an analysis with the specified settings. */
+    explicit Entropy(const Settings &settings)
+        : settings_(settings) {}
+
+    /** Initialize diagnostic output. This is called automatically when ROSE is initialized. */
+    static void initDiagnostics();
+
+    /** Property: Settings.
+     *
+     * @{ */
+    const Settings& settings() const { return settings_; }
+    Settings& settings() { return settings_; }
+    void settings(const Settings &s) { settings_ = s; }
+    /** @} */
+
+    /** Measure entropy across memory.
+     *
+     *  Slides the window across the part of the memory map that's within the specified interval and calls the callback for
+     *  each window position in increasing address order. The work is done in parallel using the number of threads specified
+     *  by the global "--threads" command-line switch, but the callback is always called from the calling thread.
+     *
+     *  Throws an @ref Exception if the settings are invalid. */
+    void scan(const MemoryMapPtr&, const AddressInterval &where, const SampleCallback&) const;
+
+    /** Classify memory by entropy.
+     *
+     *  Measures entropy like @ref scan and classifies each sample according to the thresholds in the settings. Each sample's
+     *  classification applies to the addresses from the start of its window up to the start of the next window, and the last
+     *  sample of each contiguous interval also applies to the rest of that interval. Addresses that are not mapped or that are
+     *  in contiguous intervals too small for a window are not classified. */
+    ClassifiedIntervals classify(const MemoryMapPtr&, const AddressInterval &where = AddressInterval::whole()) const;
+
+    /** Classification of a single entropy value according to the current settings. */
+    Classification classify(double entropy) const;
+
+private:
+    void checkSettings() const;
+};
+
+} // namespace
+} // namespace
+
+#endif
+#endif
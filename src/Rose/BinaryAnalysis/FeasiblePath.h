@@ -13,6 +13,7 @@
 #include <Sawyer/Message.h>
 #include <boost/filesystem/path.hpp>
 #include <boost/logic/tribool.hpp>
+#include <memory>
 
 namespace Rose {
 namespace BinaryAnalysis {
@@ -37,13 +38,15 @@ public:
     enum SearchMode {
         SEARCH_SINGLE_DFS,                              /**< Perform a depth first search. */
         SEARCH_SINGLE_BFS,                              /**< Perform a breadth first search. */
-        SEARCH_MULTI                                    /**< Blast everything at once to the SMT solver. */
+        SEARCH_MULTI,                                   /**< Blast everything at once to the SMT solver. */
+        SEARCH_PARALLEL_DFS                             /**< Depth first search split among threads at branch points. */
     };
 
     /** Organization of semantic memory. */
     enum SemanticMemoryParadigm {
         LIST_BASED_MEMORY,                              /**< Precise but slow. */
-        MAP_BASED_MEMORY                                /**< Fast but not precise. */
+        MAP_BASED_MEMORY,                               /**< Fast but not precise. */
+        INDEXED_MEMORY                                  /**< Precise like list-based, but indexed by address. */
     };
 
     /** Edge visitation order. */
@@ -104,6 +107,7 @@ public:
         Sawyer::Optional<boost::chrono::duration<double> > smtTimeout; /**< Max seconds allowed per SMT solve call. */
         size_t maxExprSize;                             /**< Maximum symbolic expression size before replacement. */
         bool traceSemantics;                            /**< Trace all instruction semantics operations. */
+        size_t nThreads;                                /**< Threads for parallel search. Zero means use the generic setting. */
 
         // Null dereferences
         struct NullDeref {
@@ -124,7 +128,7 @@ public:
               maxRecursionDepth((size_t)-1), nonAddressIsFeasible(true), solverName("best"),
               memoryParadigm(LIST_BASED_MEMORY), processFinalVertex(false), ignoreSemanticFailure(false),
               kCycleCoefficient(0.0), edgeVisitOrder(VISIT_NATURAL), trackingCodeCoverage(true), maxExprSize(UNLIMITED),
-              traceSemantics(false) {}
+              traceSemantics(false), nThreads(0) {}
     };
 
     /** Statistics from path searching. */
@@ -174,7 +178,12 @@ public:
 
     /** Path searching functor.
      *
-     *  This is the base class for user-defined functors called when searching for feasible paths. */
+     *  This is the base class for user-defined functors called when searching for feasible paths.
+     *
+     *  When the search mode is @ref SEARCH_PARALLEL_DFS the callbacks are invoked from multiple threads, but the analysis
+     *  serializes them so that no two callbacks of the same functor run concurrently. Therefore a functor need not be thread
+     *  safe, although it should not assume that paths are reported in any particular order, and the analysis, CPU, and solver
+     *  arguments may differ from one call to the next. */
     class PathProcessor {
     public:
         enum Action {
@@ -357,6 +366,9 @@ private:
     static Sawyer::Attribute::Id POST_INSN_LENGTH;      // path length in instructions at end of vertex
     static Sawyer::Attribute::Id EFFECTIVE_K;           // (double) effective maximimum path length
 
+    struct SearchContext;                               // shared state for one depth first search, defined in source file
+    struct SearchTask;                                  // state for searching the paths that extend one path prefix
+
     mutable SAWYER_THREAD_TRAITS::Mutex statsMutex_;    // protects the following data member
     Statistics stats_;                                  // statistical results of the analysis
 
@@ -575,7 +587,19 @@ public:
     /** Find all feasible paths.
      *
      *  Searches for paths and calls the @p pathProcessor each time a feasible path is found. The space is explored using a
-     *  depth first search, and the search can be limited with various @ref settings. */
+     *  depth first search, and the search can be limited with various @ref settings.
+     *
+     *  If the search mode is @ref SEARCH_PARALLEL_DFS then the search is divided into tasks at branch points of the paths
+     *  graph, and the tasks run in parallel. Each task has its own SMT solver and semantic state, and explores all paths that
+     *  extend its path prefix. All tasks start from the same initial state, which is created once for each starting vertex
+     *  before any task runs. The results do not depend on the number of threads: the same paths are explored and they are
+     *  reported to the path processor's @c found callback in the same order as by a single-threaded depth first search. To
+     *  achieve this, a task reports a path, or inlines an indirect function call whose target depends on the path, only after
+     *  all paths that come before it have been explored; other decisions about inlining and summarizing depend only on the
+     *  call site. A path processor that returns @c BREAK therefore stops the search at the same path. The path processor's
+     *  callbacks are serialized, but its @c nullDeref and @c memoryIo callbacks for different tasks may be interleaved. The
+     *  exceptions to determinism are SMT solver timeouts and random edge order, which are not reproducible even with one
+     *  thread. */
     void depthFirstSearch(PathProcessor &pathProcessor);
 
 
@@ -695,7 +719,7 @@ private:
                          const Substitutions&, bool atEndOfPath);
 
     // Mark vertex as being reached
-    void markAsReached(const Partitioner2::ControlFlowGraph::ConstVertexIterator&);
+    void markAsReached(const Partitioner2::ControlFlowGraph::ConstVertexIterator&, Statistics&);
 
     // Top-level info for debugging
     void dfsDebugHeader(Sawyer::Message::Stream &trace, Sawyer::Message::Stream &debug, size_t callId, size_t graphId);
@@ -719,8 +743,10 @@ private:
         InstructionSemantics::BaseSemantics::StatePtr originalState;
     };
 
-    // Create the parts of the instruction semantics framework.
-    Semantics createSemantics(const Partitioner2::CfgPath&, PathProcessor&, const SmtSolverPtr&);
+    // Create the parts of the instruction semantics framework. If an initial state is specified then the new semantics start
+    // with a copy of it, otherwise the initial state is created with setInitialState.
+    Semantics createSemantics(const Partitioner2::CfgPath&, PathProcessor&, const SmtSolverPtr&,
+                              const InstructionSemantics::BaseSemantics::StatePtr &initialState);
 
     // Convert a position to an index. Negative positions measure from the end of the sequence so that -1 refers to the last
     // element, -2 to the second-to-last element, etc. Non-negative positions are the same thing as an index.  Returns nothing
@@ -751,11 +777,41 @@ private:
 
     // Given an effective K value, adjust it based on how often the last vertex of the path has been visited.  Returns a new
     // effective K. As a special case, the new K is zero if the last vertex has been visited too often.
-    double adjustEffectiveK(Partitioner2::CfgPath&, double oldK);
+    double adjustEffectiveK(Partitioner2::CfgPath&, double oldK, Statistics&);
 
     // Given a path that ends with a function call, inline the function or a summary of the function, adjusting the paths_
     // control flow graph.
     void summarizeOrInline(Partitioner2::CfgPath&, const Semantics&);
+
+    // Create a task that explores all paths that extend the specified path. The task's solver gets a copy of the specified
+    // solver's assertions. The task's semantics are created when the task first runs since that might be in another thread.
+    std::unique_ptr<SearchTask> createSearchTask(const Partitioner2::CfgPath&, const SmtSolverPtr&);
+
+    // Create additional tasks for all but the first of the specified edges leaving the end of the task's path.
+    void splitSearchTask(SearchContext&, SearchTask&, const std::vector<Partitioner2::ControlFlowGraph::ConstEdgeIterator>&);
+
+    // Create a task's semantics, starting from the context's initial state if it has one.
+    void initializeSearchTask(SearchContext&, SearchTask&);
+
+    // Explore all paths of a task until it has no more paths or the search is stopped. Returns false if the task stopped
+    // partway through a step because it must wait until it's the leftmost task.
+    bool runSearchTask(SearchContext&, SearchTask&);
+
+    // Explore one path of a task and then advance to the next path. Returns false, leaving the task partway through the step,
+    // if the task must first wait for all paths that a single-threaded search would visit before this one.
+    bool searchStep(SearchContext&, SearchTask&);
+
+    // Make the task's current position in depth first order visible to the other tasks.
+    void publishSearchTaskPosition(SearchContext&, SearchTask&);
+
+    // Publish the task's position and return true if no other task could still visit a path that comes before it.
+    bool isLeftmostSearchTask(SearchContext&, SearchTask&);
+
+    // Run tasks from the context until none remain. This is the body of each search thread.
+    void searchWorker(SearchContext&);
+
+    // Move a task's statistics into the analysis' statistics.
+    void mergeStatistics(Statistics&);
 };
 
 } // namespace
@@ -99,6 +99,23 @@ public:
     /** Square matrix representing distances. */
     typedef Matrix<double> DistanceMatrix;
 
+    /** Functions nearest to some function, sorted by increasing distance. */
+    typedef std::vector<FunctionDistancePair> Neighbors;
+
+    /** Settings for approximate nearest-neighbor comparisons.
+     *
+     *  Each function's characteristic values are summarized as a fixed-length feature vector, which is reduced to a signature
+     *  of random projection sign bits. The bits are grouped into bands, and two functions are candidates for comparison if all
+     *  the bits of any band are equal. More bands find more candidates (higher recall, more work); more bits per band find
+     *  fewer candidates (lower recall, less work). */
+    struct NearestNeighborSettings {
+        size_t nBands = 16;                             /**< Number of groups of signature bits. */
+        size_t bitsPerBand = 8;                         /**< Number of signature bits per group, at most 64. */
+        size_t listBuckets = 32;                        /**< Histogram size for summarizing ordered list categories. */
+        uint64_t seed = 0;                              /**< Seed for choosing the random projections. */
+        bool exact = false;                             /**< Compare all pairs instead of only the candidates. */
+    };
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Private types and data members
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -390,6 +407,33 @@ public:
     DistanceMatrix compareManyToManyMatrix(std::vector<Partitioner2::FunctionPtr>,
                                            std::vector<Partitioner2::FunctionPtr>) const;
 
+    /** Find nearest functions.
+     *
+     *  For each function in the first list, find the @p k functions from the second list that are nearest to it according to
+     *  @ref compare. The return value has one element per function in the first list, and each element has up to @p k
+     *  functions sorted by increasing distance (ties are broken by position in the second list).
+     *
+     *  Unlike @ref compareManyToMany, which compares all pairs of functions, this function uses locality-sensitive hashing
+     *  to choose candidate pairs and compares only those, unless the @p settings request an exact search. The results are
+     *  therefore approximate: a true nearest neighbor is missed if it's never chosen as a candidate. Memory is proportional to
+     *  the number of functions rather than the number of pairs. Use @ref nearestNeighborRecall to compare the results of an
+     *  approximate search with an exact search on a set of functions to choose appropriate settings.
+     *
+     *  Throws an @ref Exception if the settings are invalid.
+     *
+     *  This analysis operates in parallel using multi-threading. It honors the global thread count usually specified with the
+     *  <code>--threads=N</code> switch. */
+    std::vector<Neighbors> compareManyToManyNearest(const std::vector<Partitioner2::FunctionPtr>&,
+                                                    const std::vector<Partitioner2::FunctionPtr>&, size_t k,
+                                                    const NearestNeighborSettings& = NearestNeighborSettings()) const;
+
+    /** Fraction of exact nearest neighbors found by an approximate search.
+     *
+     *  Given the results of two calls to @ref compareManyToManyNearest with the same arguments, one approximate and the other
+     *  exact, return the fraction of the exact neighbors that were also found by the approximate search. Returns 1.0 if the
+     *  exact search found nothing. */
+    static double nearestNeighborRecall(const std::vector<Neighbors> &approximate, const std::vector<Neighbors> &exact);
+
     /** Minimum cost 1:1 mapping.
      *
      *  Compute the minimum cost 1:1 mapping of functions in the first list to those in the second.  The algorithm first calls
@@ -478,6 +522,9 @@ public:
     // Internal functions
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
+    // Fixed-length summary of a function's characteristic values for locality-sensitive hashing.
+    std::vector<double> featureVector(const Partitioner2::FunctionPtr&, const NearestNeighborSettings&) const;
+
     static double comparePointClouds(const PointCloud&, const PointCloud&);
     static double compareOrderedLists(const OrderedLists&, const OrderedLists&);
 };
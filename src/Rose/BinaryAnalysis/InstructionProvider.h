@@ -159,6 +159,11 @@ public:
      *  This is a constant-time operation. */
     size_t nCached() const { return insnMap_.size(); }
 
+    /** Returns the cached instructions.
+     *
+     *  The cache maps each starting address to its instruction, or to null where an instruction is known to not exist. */
+    const InsnMap& instructionMap() const { return insnMap_; }
+
     /** Returns the register dictionary. */
     RegisterDictionaryPtr registerDictionary() const;
 
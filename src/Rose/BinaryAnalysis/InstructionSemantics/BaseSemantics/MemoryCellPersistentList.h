@@ -0,0 +1,294 @@
+#ifndef ROSE_BinaryAnalysis_InstructionSemantics_BaseSemantics_MemoryCellPersistentList_H
+#define ROSE_BinaryAnalysis_InstructionSemantics_BaseSemantics_MemoryCellPersistentList_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/InstructionSemantics/BaseSemantics/MemoryCellState.h>
+#include <Rose/BinaryAnalysis/InstructionSemantics/BaseSemantics/RiscOperators.h>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/export.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
+
+#include <memory>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace InstructionSemantics {
+namespace BaseSemantics {
+
+/** Shared-ownership pointer to a persistent list-based memory state. */
+typedef boost::shared_ptr<class MemoryCellPersistentList> MemoryCellPersistentListPtr;
+
+/** List-based memory state with constant-time copying.
+ *
+ *  This memory state has the same semantics as @ref MemoryCellList: cells are stored in reverse chronological order, reading
+ *  scans the list for cells that may alias the address until it finds one that must alias the address, and writing pushes a
+ *  new cell onto the front of the list. The difference is how the state is copied. Copying a @ref MemoryCellList copies every
+ *  cell, which is expensive for analyses that clone a state at every step and then modify only a few cells.
+ *
+ *  This state stores its cells in an immutable singly linked list whose tails are shared among copies of the state, so copying
+ *  the state (e.g., with @ref clone) takes constant time and writing a new cell takes constant time regardless of how many
+ *  copies exist. An operation that needs to modify existing cells (such as updating the I/O properties of cells that are read,
+ *  erasing occluded cells, or merging) first copies only the part of the list from its head through the last cell it
+ *  modifies, leaving the rest of the list shared. Reading a cell whose read properties are already set doesn't modify it and
+ *  therefore copies nothing.
+ *
+ *  Cells returned by the query functions (@ref cells, @ref matchingCells, etc.) might be shared with other copies of this state
+ *  and must not be modified. Use @ref traverse to modify cells. */
+class MemoryCellPersistentList: public MemoryCellState {
+public:
+    /** Base type. */
+    using Super = MemoryCellState;
+
+    /** Shared-ownership pointer. */
+    using Ptr = MemoryCellPersistentListPtr;
+
+private:
+    // One element of the cell list. A node is shared by all states whose lists contain it, and a node reachable from the head
+    // of a list only through nodes whose reference counts are one is owned exclusively by that list. Each cell belongs to
+    // exactly one node, so a cell can be modified in place only when its node is owned exclusively.
+    struct Node {
+        MemoryCellPtr cell;
+        std::shared_ptr<Node> next;
+
+        Node(const MemoryCellPtr &cell, const std::shared_ptr<Node> &next)
+            : cell(cell), next(next) {}
+    };
+
+    std::shared_ptr<Node> head_;                        // most recent cell, or null
+    size_t nCells_;                                     // number of nodes in the list
+    bool occlusionsErased_;                             // prune away old cells that are occluded by newer ones.
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Serialization
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void save(S &s, const unsigned /*version*/) const {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(MemoryCellState);
+        const CellList list = cells();
+        s & boost::serialization::make_nvp("cells", list);
+        s & BOOST_SERIALIZATION_NVP(occlusionsErased_);
+    }
+
+    template<class S>
+    void load(S &s, const unsigned /*version*/) {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(MemoryCellState);
+        CellList list;
+        s & boost::serialization::make_nvp("cells", list);
+        s & BOOST_SERIALIZATION_NVP(occlusionsErased_);
+        releaseNodes();
+        for (auto cell = list.rbegin(); cell != list.rend(); ++cell)
+            pushFront(*cell);
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER();
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    MemoryCellPersistentList()                          // for serialization
+        : nCells_(0), occlusionsErased_(false) {}
+
+    explicit MemoryCellPersistentList(const MemoryCellPtr &protocell)
+        : MemoryCellState(protocell), nCells_(0), occlusionsErased_(false) {}
+
+    MemoryCellPersistentList(const SValuePtr &addrProtoval, const SValuePtr &valProtoval)
+        : MemoryCellState(addrProtoval, valProtoval), nCells_(0), occlusionsErased_(false) {}
+
+    // Shares the entire cell list with the other state.
+    MemoryCellPersistentList(const MemoryCellPersistentList &other)
+        : MemoryCellState(other), head_(other.head_), nCells_(other.nCells_), occlusionsErased_(other.occlusionsErased_) {}
+
+public:
+    ~MemoryCellPersistentList();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiate a new prototypical memory state. This constructor uses the default type for the cell type (based on the
+     *  semantic domain). The prototypical values are usually the same (addresses and stored values are normally the same
+     *  type). */
+    static MemoryCellPersistentListPtr instance(const SValuePtr &addrProtoval, const SValuePtr &valProtoval) {
+        return MemoryCellPersistentListPtr(new MemoryCellPersistentList(addrProtoval, valProtoval));
+    }
+
+    /** Instantiate a new memory state with prototypical memory cell. */
+    static MemoryCellPersistentListPtr instance(const MemoryCellPtr &protocell) {
+        return MemoryCellPersistentListPtr(new MemoryCellPersistentList(protocell));
+    }
+
+    /** Instantiate a new copy of an existing memory state.
+     *
+     *  This takes constant time since the new state shares its cells with the @p other state. */
+    static MemoryCellPersistentListPtr instance(const MemoryCellPersistentListPtr &other) {
+        return MemoryCellPersistentListPtr(new MemoryCellPersistentList(*other));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    virtual MemoryStatePtr create(const SValuePtr &addrProtoval, const SValuePtr &valProtoval) const override {
+        return instance(addrProtoval, valProtoval);
+    }
+
+    /** Virtual allocating constructor. */
+    virtual MemoryStatePtr create(const MemoryCellPtr &protocell) const {
+        return instance(protocell);
+    }
+
+    virtual MemoryStatePtr clone() const override {
+        return MemoryStatePtr(new MemoryCellPersistentList(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Promote a base memory state pointer to a BaseSemantics::MemoryCellPersistentList pointer. The memory state @p m must
+     *  have a BaseSemantics::MemoryCellPersistentList dynamic type. */
+    static MemoryCellPersistentListPtr promote(const BaseSemantics::MemoryStatePtr &m) {
+        MemoryCellPersistentListPtr retval = boost::dynamic_pointer_cast<MemoryCellPersistentList>(m);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods we inherited
+public:
+    virtual void clear() override;
+    virtual bool merge(const MemoryStatePtr &other, RiscOperators *addrOps, RiscOperators *valOps) override;
+    virtual std::vector<MemoryCellPtr> matchingCells(MemoryCell::Predicate&) const override;
+    virtual std::vector<MemoryCellPtr> leadingCells(MemoryCell::Predicate&) const override;
+    virtual void eraseMatchingCells(MemoryCell::Predicate&) override;
+    virtual void eraseLeadingCells(MemoryCell::Predicate&) override;
+    virtual void traverse(MemoryCell::Visitor&) override;
+    virtual void hash(Combinatorics::Hasher&, RiscOperators *addrOps, RiscOperators *valOps) const override;
+
+    /** Read a value from memory.
+     *
+     *  This has the same semantics as @ref MemoryCellList::readMemory. */
+    virtual SValuePtr readMemory(const SValuePtr &address, const SValuePtr &dflt,
+                                 RiscOperators *addrOps, RiscOperators *valOps) override;
+
+    virtual SValuePtr peekMemory(const SValuePtr &address, const SValuePtr &dflt,
+                                 RiscOperators *addrOps, RiscOperators *valOps) override;
+
+    /** Write a value to memory.
+     *
+     *  This has the same semantics as @ref MemoryCellList::writeMemory. Unless the @ref occlusionsErased property is set, this
+     *  takes constant time. */
+    virtual void writeMemory(const SValuePtr &addr, const SValuePtr &value,
+                             RiscOperators *addrOps, RiscOperators *valOps) override;
+
+    virtual void print(std::ostream&, Formatter&) const override;
+
+    virtual AddressSet getWritersUnion(const SValuePtr &addr, size_t nBits, RiscOperators *addrOps,
+                                       RiscOperators *valOps) override;
+
+    virtual AddressSet getWritersIntersection(const SValuePtr &addr, size_t nBits, RiscOperators *addrOps,
+                                              RiscOperators *valOps) override;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods first declared at this level of the class hierarchy
+public:
+    /** Merge two states without aliasing.
+     *
+     *  See @ref MemoryCellList::mergeNoAliasing. */
+    bool mergeNoAliasing(const MemoryStatePtr &other, RiscOperators *addrOps, RiscOperators *valOps);
+
+    /** Merge two states with aliasing.
+     *
+     *  See @ref MemoryCellList::mergeWithAliasing. */
+    bool mergeWithAliasing(const MemoryStatePtr &other, RiscOperators *addrOps, RiscOperators *valOps);
+
+    /** Predicate to determine whether all bytes are present.
+     *
+     *  Returns true if bytes at the specified address and the following consecutive addresses are all present in this
+     *  memory state. */
+    virtual bool isAllPresent(const SValuePtr &address, size_t nBytes, RiscOperators *addrOps, RiscOperators *valOps) const;
+
+    /** Property: erase occluded cells.
+     *
+     *  If this property is true, then writing a new cell to memory will also erase all older cells that must alias the new
+     *  cell. Erasing cells requires copying the shared part of the list up to the last erased cell.
+     *
+     * @{ */
+    bool occlusionsErased() const { return occlusionsErased_; }
+    void occlusionsErased(bool b) { occlusionsErased_ = b; }
+    /** @} */
+
+    /** Number of cells in the list. */
+    size_t nCells() const { return nCells_; }
+
+    /** All cells in reverse chronological order.
+     *
+     *  The returned cells might be shared with other states and must not be modified. */
+    CellList cells() const;
+
+    /** Scan cell list to find matching cells.
+     *
+     *  Scans the cell list from front to back (reverse chronological order) and returns the cells that may alias the given
+     *  address and size, also in reverse chronological order. The scan ends either when a cell that must alias the address is
+     *  found, in which case @p foundMustAlias is set, or when the end of the list is reached. The returned cells might be shared
+     *  with other states and must not be modified. */
+    CellList scan(const SValuePtr &addr, size_t nBits, RiscOperators *addrOps, RiscOperators *valOps,
+                  bool &foundMustAlias /*out*/) const;
+
+protected:
+    // Like scan, but also returns the zero-origin position of each returned cell in the list.
+    CellList scan(const SValuePtr &addr, size_t nBits, RiscOperators *addrOps, RiscOperators *valOps,
+                  bool &foundMustAlias /*out*/, std::vector<size_t> &positions /*out*/) const;
+
+    // Cells at the specified positions, which must be sorted.
+    CellList cellsAt(const std::vector<size_t> &positions) const;
+
+    // Make sure the first n nodes of the list are owned exclusively by this state so their cells can be modified. Shared
+    // nodes are replaced by copies having copies of the cells.
+    void unsharePrefix(size_t n);
+
+    // Remove the nodes at the specified sorted positions, copying shared nodes that precede them.
+    void eraseAt(const std::vector<size_t> &positions);
+
+    // Push a cell onto the front of the list.
+    void pushFront(const MemoryCellPtr&);
+
+    // Compute a new value by merging the specified cells.  If the cell list is empty return the specified default.
+    virtual SValuePtr mergeCellValues(const CellList &cells, const SValuePtr &dflt, RiscOperators *addrOps,
+                                      RiscOperators *valOps);
+
+    // Returns the union of all writers from the specified cells.
+    virtual AddressSet mergeCellWriters(const CellList &cells);
+
+    // Returns the union of all properties from the specified cells.
+    virtual InputOutputPropertySet mergeCellProperties(const CellList &cells);
+
+    // Insert a new cell at the head of the list. It's writers set is empty and its I/O properties will be READ,
+    // READ_BEFORE_WRITE, and READ_UNINITIALIZED.
+    virtual MemoryCellPtr insertReadCell(const SValuePtr &addr, const SValuePtr &value);
+
+    // Insert a new cell at the head of the list.  The specified writers and I/O properties are used.
+    virtual MemoryCellPtr insertReadCell(const SValuePtr &addr, const SValuePtr &value,
+                                         const AddressSet &writers, const InputOutputPropertySet &props);
+
+private:
+    // Drop this state's references to the list without recursing through long chains of exclusively owned nodes.
+    void releaseNodes();
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::BaseSemantics::MemoryCellPersistentList);
+#endif
+
+#endif
+#endif
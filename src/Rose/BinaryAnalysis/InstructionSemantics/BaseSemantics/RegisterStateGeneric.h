@@ -11,8 +11,11 @@
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/nvp.hpp>
 #include <Sawyer/IntervalSetMap.h>
 
+#include <memory>
+
 namespace Rose {
 namespace BinaryAnalysis {
 namespace InstructionSemantics {
@@ -165,8 +168,10 @@ public:
     //                                  Data members
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
-    RegisterProperties properties_;                     // Boolean properties for each bit of each register.
-    RegisterAddressSet writers_;                        // Writing instruction address set for each bit of each register
+    // The three containers are shared copy-on-write between copies of a state: copying a state copies only the pointers, and
+    // a container is copied the first time a state that shares it needs to modify it. See the "mutable" accessors below.
+    std::shared_ptr<RegisterProperties> properties_;    // Boolean properties for each bit of each register.
+    std::shared_ptr<RegisterAddressSet> writers_;       // Writing instruction address set for each bit of each register
     bool accessModifiesExistingLocations_;              // Can read/write modify existing locations?
     bool accessCreatesLocations_;                       // Can new locations be created?
 
@@ -178,8 +183,11 @@ protected:
      *  overlap only with those registers on the matching major-minor list, if it overlaps at all.  The lists are typically
      *  short (e.g., one list might refer to all the parts of the x86 RAX register, but the RBX parts would be on a different
      *  list. None of the registers stored on a particular list overlap with any other register on that same list; when adding
-     *  new register that would overlap, the registers with which it overlaps must be removed first. */
-    Registers registers_;
+     *  new register that would overlap, the registers with which it overlaps must be removed first.
+     *
+     *  The map might be shared with other register states, therefore subclasses should modify it only through the reference
+     *  returned by @ref mutableRegisters. */
+    std::shared_ptr<Registers> registers_;
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Serialization
@@ -191,11 +199,11 @@ private:
     template<class S>
     void serialize(S &s, const unsigned /*version*/) {
         s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(RegisterState);
-        s & BOOST_SERIALIZATION_NVP(properties_);
-        s & BOOST_SERIALIZATION_NVP(writers_);
+        s & boost::serialization::make_nvp("properties_", mutableProperties());
+        s & boost::serialization::make_nvp("writers_", mutableWriters());
         s & BOOST_SERIALIZATION_NVP(accessModifiesExistingLocations_);
         s & BOOST_SERIALIZATION_NVP(accessCreatesLocations_);
-        s & BOOST_SERIALIZATION_NVP(registers_);
+        s & boost::serialization::make_nvp("registers_", mutableRegisters());
     }
 #endif
     
@@ -206,18 +214,27 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 protected:
     RegisterStateGeneric()                              // for serialization
-        : accessModifiesExistingLocations_(true), accessCreatesLocations_(true) {}
+        : properties_(std::make_shared<RegisterProperties>()), writers_(std::make_shared<RegisterAddressSet>()),
+          accessModifiesExistingLocations_(true), accessCreatesLocations_(true), registers_(std::make_shared<Registers>()) {}
 
     explicit RegisterStateGeneric(const SValuePtr &protoval, const RegisterDictionaryPtr &regdict)
-        : RegisterState(protoval, regdict), accessModifiesExistingLocations_(true), accessCreatesLocations_(true) {
+        : RegisterState(protoval, regdict), properties_(std::make_shared<RegisterProperties>()),
+          writers_(std::make_shared<RegisterAddressSet>()), accessModifiesExistingLocations_(true),
+          accessCreatesLocations_(true), registers_(std::make_shared<Registers>()) {
         clear();
     }
 
     RegisterStateGeneric(const RegisterStateGeneric &other)
+        : RegisterStateGeneric(other, true) {}
+
+    // Copy constructor that shares all storage with the other state. If deepCopyValues is set then the register values are
+    // also copied (which also unshares the register map), otherwise the values are shared with the other state.
+    RegisterStateGeneric(const RegisterStateGeneric &other, bool deepCopyValues)
         : RegisterState(other), properties_(other.properties_), writers_(other.writers_),
           accessModifiesExistingLocations_(other.accessModifiesExistingLocations_),
           accessCreatesLocations_(other.accessCreatesLocations_), registers_(other.registers_) {
-        deep_copy_values();
+        if (deepCopyValues)
+            deep_copy_values();
     }
 
 
@@ -605,6 +622,12 @@ public:
 protected:
     void deep_copy_values();
 
+    // Containers that may be modified. If the container is shared with some other register state then it's first copied so
+    // that modifying it doesn't affect the other state.
+    Registers& mutableRegisters();
+    RegisterProperties& mutableProperties();
+    RegisterAddressSet& mutableWriters();
+
     // Given a register descriptor return information about what's stored in the state. The two return values are:
     //
     //     accessedParts represent the parts of the reigster (matching major and minor numbers) that are present in the
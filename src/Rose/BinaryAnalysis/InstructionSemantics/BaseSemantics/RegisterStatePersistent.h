@@ -0,0 +1,111 @@
+#ifndef ROSE_BinaryAnalysis_InstructionSemantics_BaseSemantics_RegisterStatePersistent_H
+#define ROSE_BinaryAnalysis_InstructionSemantics_BaseSemantics_RegisterStatePersistent_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_BINARY_ANALYSIS
+
+#include <Rose/BinaryAnalysis/InstructionSemantics/BaseSemantics/RegisterStateGeneric.h>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/export.hpp>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace InstructionSemantics {
+namespace BaseSemantics {
+
+/** Shared-ownership pointer to persistent register states. */
+typedef boost::shared_ptr<class RegisterStatePersistent> RegisterStatePersistentPtr;
+
+/** A generic register state with constant-time copying.
+ *
+ *  This register state behaves like @ref RegisterStateGeneric in every respect except for how it's copied. Copying a
+ *  @ref RegisterStateGeneric copies the register map, the writer sets, the I/O properties, and also every register value. An
+ *  analysis that clones a state at each control flow vertex (such as a data-flow analysis or a path explorer) therefore spends
+ *  time proportional to the size of the state at every step even though each instruction typically touches only a few
+ *  registers.
+ *
+ *  Copying a persistent register state (e.g., via @ref clone) copies only a few pointers: the copy shares its register map, writer
+ *  sets, and I/O properties with the original. Each of those containers is copied the first time either state modifies it, and
+ *  the other containers remain shared. For example, writing a register in a state that was just cloned copies the register map
+ *  but not the writers or properties.
+ *
+ *  The register values themselves are never copied, which means that the semantic values stored in a persistent state are
+ *  shared with all its copies. This is safe as long as values are treated as immutable, which is the case for the values
+ *  produced by the RISC operators of all ROSE semantic domains. Users should not modify a value read from a persistent register
+ *  state in place (e.g., by changing its comment) unless they're prepared for that modification to be visible in other copies
+ *  of the state. The @ref traverse method copies the values before visiting them since the visitor is permitted to modify them. */
+class RegisterStatePersistent: public RegisterStateGeneric {
+public:
+    /** Base type. */
+    using Super = RegisterStateGeneric;
+
+    /** Shared-ownership pointer. */
+    using Ptr = RegisterStatePersistentPtr;
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void serialize(S &s, const unsigned /*version*/) {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(RegisterStateGeneric);
+    }
+#endif
+
+protected:
+    RegisterStatePersistent() {}                        // for serialization
+
+    RegisterStatePersistent(const SValuePtr &protoval, const RegisterDictionaryPtr &regdict)
+        : RegisterStateGeneric(protoval, regdict) {}
+
+    // Shares storage and values with the other state.
+    RegisterStatePersistent(const RegisterStatePersistent &other)
+        : RegisterStateGeneric(other, false) {}
+
+public:
+    /** Instantiate a new register state. See @ref RegisterStateGeneric::instance. */
+    static RegisterStatePersistentPtr instance(const SValuePtr &protoval, const RegisterDictionaryPtr &regdict) {
+        return RegisterStatePersistentPtr(new RegisterStatePersistent(protoval, regdict));
+    }
+
+    /** Instantiate a new copy of an existing register state.
+     *
+     *  This takes constant time since the new state shares its storage with the @p other state. */
+    static RegisterStatePersistentPtr instance(const RegisterStatePersistentPtr &other) {
+        return RegisterStatePersistentPtr(new RegisterStatePersistent(*other));
+    }
+
+public:
+    virtual RegisterStatePtr create(const SValuePtr &protoval, const RegisterDictionaryPtr &regdict) const override {
+        return instance(protoval, regdict);
+    }
+
+    virtual RegisterStatePtr clone() const override {
+        return RegisterStatePersistentPtr(new RegisterStatePersistent(*this));
+    }
+
+public:
+    /** Run-time promotion of a base register state pointer to a RegisterStatePersistent pointer. This is a checked
+     *  conversion--it will fail if @p from does not point to a RegisterStatePersistent object. */
+    static RegisterStatePersistentPtr promote(const RegisterStatePtr &from) {
+        RegisterStatePersistentPtr retval = boost::dynamic_pointer_cast<RegisterStatePersistent>(from);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+public:
+    virtual void traverse(Visitor&) override;
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::BaseSemantics::RegisterStatePersistent);
+#endif
+
+#endif
+#endif
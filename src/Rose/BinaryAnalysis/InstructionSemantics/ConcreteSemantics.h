@@ -10,8 +10,13 @@
 
 #include <Rose/BinaryAnalysis/BasicTypes.h>
 #include "integerOps.h"
+#include <Rose/BinaryAnalysis/Disassembler/BasicTypes.h>
 #include <Rose/BinaryAnalysis/InstructionSemantics/BaseSemantics.h>
 #include <Sawyer/BitVector.h>
+#include <Sawyer/HashMap.h>
+#include <Sawyer/IntervalSet.h>
+
+#include <memory>
 
 namespace Rose {
 namespace BinaryAnalysis {              // documented elsewhere
@@ -338,6 +343,161 @@ typedef BaseSemantics::State State;
 typedef BaseSemantics::StatePtr StatePtr;
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Block cache
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to a block cache. */
+typedef Sawyer::SharedPointer<class BlockCache> BlockCachePtr;
+
+/** Cache of decoded basic blocks for concrete emulation.
+ *
+ *  An emulator that decodes each instruction from memory before processing it spends much of its time in the instruction
+ *  decoder, re-decoding the same loop bodies over and over. This cache decodes each basic block once, the first time execution
+ *  reaches its starting address, and keeps the instructions so that later executions of the block don't need the decoder.
+ *
+ *  When the block is executed by a stock x86 dispatcher (@ref DispatcherX86) whose RISC operators and memory state are exactly
+ *  this namespace's @ref RiscOperators and @ref MemoryState, the block is also lowered to an array of micro-ops, one per
+ *  instruction. The micro-ops have their operands already decoded into register numbers, immediate values, and address
+ *  terms, and they are executed by an interpreter that keeps the general purpose registers, the status flags, and the
+ *  instruction pointer in native 64-bit integers and accesses memory directly through the memory map. This avoids the
+ *  dispatcher's per-instruction functor lookup, the walk over the operand expression trees, and the allocation of semantic
+ *  values. The micro-ops cover the common integer instructions (moves, LEA, integer arithmetic and logic, shifts by an
+ *  immediate or CL, pushes and pops, calls, returns, jumps, SETcc and CMOVcc) and compute the same results and flags as @ref
+ *  DispatcherX86, except that a memory address wraps around at the instruction's address size as it does on the hardware
+ *  (the dispatcher computes addresses at the full address width). Any other instruction, and any access to memory that isn't
+ *  already mapped, is handed to the dispatcher's @ref BaseSemantics::Dispatcher::processInstruction "processInstruction" after
+ *  the interpreter's registers are written back to the state. Because the interpreter writes registers back to the state only
+ *  at the end of a block or before such a fallback, register I/O properties and writer lists are not updated per instruction.
+ *  If the dispatcher's instruction functors have been replaced, turn off lowering with the @ref lowering property.
+ *
+ *  Blocks are decoded from the memory map of the concrete memory state, so the cache must be told when that memory changes.
+ *  Attaching the cache to the concrete RISC operators (see @ref RiscOperators::blockCache) causes every memory write that
+ *  overlaps a cached block to discard that block, which handles self-modifying code. Writes that don't touch cached code cost
+ *  one interval lookup. The micro-op interpreter discards blocks the same way.
+ *
+ *  The instructions of a discarded block are deleted when the block is destroyed. The cache holds on to discarded blocks until
+ *  the next call to @ref execute or @ref block, so that an instruction referenced by an exception thrown from @ref execute is
+ *  still valid while the exception is handled. */
+class BlockCache: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer. */
+    using Ptr = BlockCachePtr;
+
+    /** Lowered form of a block's instructions. */
+    struct MicroOps;
+
+    /** A decoded basic block.
+     *
+     *  The block owns its instructions and deletes them when it's destroyed. */
+    struct Block {
+        std::vector<SgAsmInstruction*> instructions;    /**< Instructions in execution order. */
+        AddressInterval extent;                         /**< Addresses occupied by the instructions. */
+        std::shared_ptr<const MicroOps> microOps;       /**< Lowered instructions, or null if not lowered. */
+
+        Block() {}
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+        ~Block();
+    };
+
+    /** Shared-ownership pointer to a block. */
+    using BlockPtr = std::shared_ptr<const Block>;
+
+private:
+    Disassembler::BasePtr decoder_;
+    size_t maxInstructions_ = 256;                      // max instructions per block
+    bool lowering_ = true;                              // lower blocks to micro-ops when the dispatcher allows it
+    Sawyer::Container::HashMap<rose_addr_t, std::shared_ptr<Block>> blocks_; // blocks indexed by starting address
+    Sawyer::Container::IntervalSet<AddressInterval> code_; // addresses occupied by cached blocks
+    std::vector<BlockPtr> retired_;                     // discarded blocks kept until the next execute or block call
+    size_t nInvalidations_ = 0;                         // number of times cached blocks were discarded
+    size_t nHits_ = 0;                                  // number of block lookups satisfied by the cache
+    size_t nMisses_ = 0;                                // number of block lookups that needed to decode
+    size_t nInterpreted_ = 0;                           // number of instructions executed as micro-ops
+    size_t nDispatched_ = 0;                            // number of instructions executed by the dispatcher
+
+protected:
+    explicit BlockCache(const Disassembler::BasePtr&);
+
+public:
+    ~BlockCache();
+
+    /** Allocating constructor.
+     *
+     *  The decoder must be for the same instruction set architecture as the dispatcher that will process the instructions. */
+    static Ptr instance(const Disassembler::BasePtr&);
+
+    /** Property: Instruction decoder. */
+    Disassembler::BasePtr decoder() const;
+
+    /** Property: Maximum number of instructions per block.
+     *
+     *  Blocks normally end at an instruction that terminates a basic block, but very long straight-line code is split into
+     *  multiple blocks of at most this many instructions.
+     *
+     * @{ */
+    size_t maxInstructions() const;
+    void maxInstructions(size_t);
+    /** @} */
+
+    /** Property: Whether to lower blocks to micro-ops.
+     *
+     *  When true (the default), @ref execute lowers each block to micro-ops and runs them with the micro-op interpreter if the
+     *  dispatcher and state allow it. When false, every instruction is processed by the dispatcher.
+     *
+     * @{ */
+    bool lowering() const;
+    void lowering(bool);
+    /** @} */
+
+    /** Number of blocks in the cache. */
+    size_t nBlocks() const;
+
+    /** Number of block lookups that were satisfied by the cache. */
+    size_t nHits() const;
+
+    /** Number of block lookups that required decoding. */
+    size_t nMisses() const;
+
+    /** Number of instructions executed by the micro-op interpreter. */
+    size_t nInterpreted() const;
+
+    /** Number of instructions executed by the dispatcher. */
+    size_t nDispatched() const;
+
+    /** Discard all cached blocks. */
+    void clear();
+
+    /** Block starting at the specified address.
+     *
+     *  Returns the cached block if there is one, otherwise decodes the block from the memory map and caches it. Returns null if
+     *  not even one instruction can be decoded at the specified address. */
+    BlockPtr block(const MemoryMapPtr&, rose_addr_t va);
+
+    /** True if any cached block occupies any of the specified addresses. */
+    bool isCode(const AddressInterval&) const;
+
+    /** Discard cached blocks that occupy any of the specified addresses. */
+    void invalidate(const AddressInterval&);
+
+    /** Execute one basic block.
+     *
+     *  Reads the instruction pointer from the dispatcher's current state, obtains the block starting at that address from the
+     *  cache (decoding it from the current memory state if necessary), and executes its instructions, either as micro-ops or
+     *  with the dispatcher (see the class documentation). Execution of the block stops early if an instruction leaves the
+     *  instruction pointer somewhere other than the following instruction (such as an x86 instruction with a repeat prefix)
+     *  or writes to cached code. Returns the number of instructions executed, which is zero if no instruction could be
+     *  decoded at the instruction pointer.
+     *
+     *  Exceptions thrown by the dispatcher are propagated to the caller. */
+    size_t execute(const BaseSemantics::DispatcherPtr&);
+
+private:
+    std::shared_ptr<Block> findOrDecode(const MemoryMapPtr&, rose_addr_t va);
+    void retire(const std::shared_ptr<Block>&);
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      RISC operators
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -370,6 +530,9 @@ public:
     /** Shared-ownership pointer. */
     using Ptr = RiscOperatorsPtr;
 
+private:
+    BlockCachePtr blockCache_;                          // optional cache to be notified about writes to code
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
@@ -416,6 +579,19 @@ public:
      *  will fail if @p x does not point to a ConcreteSemantics::RiscOperators object. */
     static RiscOperatorsPtr promote(const BaseSemantics::RiscOperatorsPtr&);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Properties
+public:
+    /** Property: Block cache.
+     *
+     *  If a block cache is present, then memory writes that overlap cached blocks cause those blocks to be discarded. See @ref
+     *  BlockCache.
+     *
+     * @{ */
+    BlockCachePtr blockCache() const;
+    void blockCache(const BlockCachePtr&);
+    /** @} */
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // New methods for constructing values, so we don't have to write so many SValue::promote calls in the RiscOperators
     // implementations.
@@ -662,6 +662,15 @@ protected:
                                               BaseSemantics::RiscOperators *valOps,
                                               AllowSideEffects::Flag allowSideEffects);
 
+    /** Find cells that may alias an address.
+     *
+     *  Returns the cells that may alias the specified address in reverse chronological order, ending with the most recent cell
+     *  that must alias the address if there is one. The @p foundMustAlias argument indicates whether the scan was terminated by
+     *  such a cell. The base implementation uses @ref scan. */
+    virtual BaseSemantics::CellList findAliases(const BaseSemantics::SValuePtr &address, size_t nBits,
+                                                BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps,
+                                                bool &foundMustAlias /*out*/) const;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods first declared in this class
 public:
@@ -680,6 +689,202 @@ public:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Indexed list-based Memory state
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer for symbolic indexed list-based memory state. */
+typedef boost::shared_ptr<class MemoryIndexedState> MemoryIndexedStatePtr;
+
+/** Byte-addressable memory with an address index.
+ *
+ *  This is a @ref MemoryListState with the same aliasing semantics, but which also indexes its cells by address so that a memory
+ *  operation doesn't need to compare the address against every cell in the list. The index groups cells whose addresses are
+ *  integer constants, and cells whose addresses have the form V or V + C where V is an integer variable and C is an integer
+ *  constant. Within a group, cells are further indexed by their constant part. When looking for cells that alias an address,
+ *  the index rules out cells whose addresses are in the same group but have a different constant part since such addresses
+ *  can never be equal (this is the same reasoning that @ref SymbolicExpression::Node::mayEqual uses without a solver). All
+ *  remaining cells are checked with the usual may-alias and must-alias predicates in reverse chronological order, so the
+ *  result is the same as scanning the whole list, but for typical stack-heavy code most of the list is never touched and the
+ *  SMT solver is invoked far less often.
+ *
+ *  Addresses that cannot be indexed (other expressions, bottom values, or cells whose values aren't one byte) are always
+ *  treated as potential aliases, and lookups with such addresses scan the whole list. The cell list returned by @ref
+ *  get_cells remains the authoritative representation of the state; if a caller modifies it directly then it must call @ref
+ *  invalidateIndex afterward.
+ *
+ *  @sa MemoryListState, MemoryMapState */
+class MemoryIndexedState: public MemoryListState {
+public:
+    /** Base type. */
+    using Super = MemoryListState;
+
+    /** Shared-ownership pointer. */
+    using Ptr = MemoryIndexedStatePtr;
+
+private:
+    // How a cell address is indexed.
+    struct IndexKey {
+        enum Kind { UNINDEXED, CONSTANT, VARIABLE };
+        Kind kind = UNINDEXED;
+        uint64_t base = 0;                              // variable name ID for VARIABLE keys
+        uint64_t offset = 0;                            // constant address or constant part of V + C
+    };
+
+    // A cell and its insertion serial number. Serial numbers increase with time, therefore they order the cells the same way as
+    // the cell list (but reversed).
+    struct IndexedCell {
+        uint64_t serial;
+        BaseSemantics::MemoryCellPtr cell;
+    };
+
+    // Cells sorted by increasing serial number.
+    using IndexedCells = std::vector<IndexedCell>;
+
+    // Cells whose addresses are all constants, or all based on the same variable.
+    struct CellGroup {
+        IndexedCells cells;                             // all cells in the group
+        std::map<uint64_t, IndexedCells> byOffset;      // the same cells partitioned by the constant part of their address
+    };
+
+    // The index is built lazily from the cell list and is therefore not part of the logical state.
+    mutable CellGroup constants_;                       // cells whose addresses are integer constants
+    mutable std::map<uint64_t, CellGroup> variables_;   // cells whose addresses are V or V + C, keyed by V's name ID
+    mutable IndexedCells unindexed_;                    // cells that might alias anything
+    mutable uint64_t nextSerial_ = 0;                   // serial number for the next indexed cell
+    mutable bool indexIsValid_ = false;                 // whether the index reflects the cell list
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Serialization
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+private:
+    friend class boost::serialization::access;
+
+    template<class S>
+    void serialize(S &s, const unsigned /*version*/) {
+        s & BOOST_SERIALIZATION_BASE_OBJECT_NVP(Super);
+        // the index is rebuilt from the cell list on demand
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    MemoryIndexedState() {}                             // for serialization
+
+    explicit MemoryIndexedState(const BaseSemantics::MemoryCellPtr &protocell)
+        : MemoryListState(protocell) {}
+
+    MemoryIndexedState(const BaseSemantics::SValuePtr &addrProtoval, const BaseSemantics::SValuePtr &valProtoval)
+        : MemoryListState(addrProtoval, valProtoval) {}
+
+    // The index refers to the other state's cells, so it's rebuilt for the copied cells when it's next needed.
+    MemoryIndexedState(const MemoryIndexedState &other)
+        : MemoryListState(other) {}
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiates a new memory state having specified prototypical cells and value. */
+    static MemoryIndexedStatePtr instance(const BaseSemantics::MemoryCellPtr &protocell) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(protocell));
+    }
+
+    /** Instantiates a new memory state having specified prototypical value.  This constructor uses BaseSemantics::MemoryCell
+     * as the cell type. */
+    static MemoryIndexedStatePtr instance(const BaseSemantics::SValuePtr &addrProtoval,
+                                          const BaseSemantics::SValuePtr &valProtoval) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(addrProtoval, valProtoval));
+    }
+
+    /** Instantiates a new deep copy of an existing state. */
+    static MemoryIndexedStatePtr instance(const MemoryIndexedStatePtr &other) {
+        return MemoryIndexedStatePtr(new MemoryIndexedState(*other));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    virtual BaseSemantics::MemoryStatePtr create(const BaseSemantics::SValuePtr &addrProtoval,
+                                                 const BaseSemantics::SValuePtr &valProtoval) const override {
+        return instance(addrProtoval, valProtoval);
+    }
+
+    virtual BaseSemantics::MemoryStatePtr create(const BaseSemantics::MemoryCellPtr &protocell) const override {
+        return instance(protocell);
+    }
+
+    virtual BaseSemantics::MemoryStatePtr clone() const override {
+        return BaseSemantics::MemoryStatePtr(new MemoryIndexedState(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Recasts a base pointer to a symbolic indexed memory state. This is a checked cast that will fail if the specified pointer
+     *  does not have a run-time type that is a SymbolicSemantics::MemoryIndexedState or subclass thereof. */
+    static MemoryIndexedStatePtr promote(const BaseSemantics::MemoryStatePtr &x) {
+        MemoryIndexedStatePtr retval = boost::dynamic_pointer_cast<MemoryIndexedState>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods we override from the super class (documented in the super class)
+public:
+    virtual void clear() override;
+    virtual void writeMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &value,
+                             BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps) override;
+    virtual bool isAllPresent(const BaseSemantics::SValuePtr &address, size_t nBytes, BaseSemantics::RiscOperators *addrOps,
+                              BaseSemantics::RiscOperators *valOps) const override;
+    virtual AddressSet getWritersUnion(const BaseSemantics::SValuePtr &addr, size_t nBits, BaseSemantics::RiscOperators *addrOps,
+                                       BaseSemantics::RiscOperators *valOps) override;
+    virtual AddressSet getWritersIntersection(const BaseSemantics::SValuePtr &addr, size_t nBits,
+                                              BaseSemantics::RiscOperators *addrOps,
+                                              BaseSemantics::RiscOperators *valOps) override;
+    virtual void eraseMatchingCells(BaseSemantics::MemoryCell::Predicate&) override;
+    virtual void eraseLeadingCells(BaseSemantics::MemoryCell::Predicate&) override;
+    virtual void traverse(BaseSemantics::MemoryCell::Visitor&) override;
+
+protected:
+    virtual BaseSemantics::CellList findAliases(const BaseSemantics::SValuePtr &address, size_t nBits,
+                                                BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps,
+                                                bool &foundMustAlias /*out*/) const override;
+    virtual BaseSemantics::MemoryCellPtr insertReadCell(const BaseSemantics::SValuePtr &addr,
+                                                        const BaseSemantics::SValuePtr &value) override;
+    virtual BaseSemantics::MemoryCellPtr insertReadCell(const BaseSemantics::SValuePtr &addr,
+                                                        const BaseSemantics::SValuePtr &value,
+                                                        const AddressSet &writers,
+                                                        const BaseSemantics::InputOutputPropertySet &props) override;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods first declared in this class
+public:
+    /** Discard the address index.
+     *
+     *  The index is rebuilt from the cell list the next time it's needed. This must be called by anything that modifies the
+     *  cell list or the cell addresses directly rather than through this class's methods. */
+    void invalidateIndex();
+
+private:
+    // Compute the index key for an address.
+    static IndexKey indexKey(const BaseSemantics::SValuePtr &address, size_t nBits);
+
+    // Build the index from the cell list if necessary.
+    void updateIndex() const;
+
+    // Add a new cell to the index. It must be the most recent cell.
+    void indexCell(const BaseSemantics::MemoryCellPtr&) const;
+
+    // Remove a cell from the index.
+    void unindexCell(const BaseSemantics::MemoryCellPtr&) const;
+
+    // Cells that the index can't rule out as aliases of an address with the specified key, having serial numbers greater than
+    // or equal to @p minSerial. The return value is sorted by decreasing serial number (reverse chronological order).
+    IndexedCells candidates(const IndexKey&, uint64_t minSerial) const;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Map-based Memory state
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1258,6 +1463,7 @@ public:
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::SymbolicSemantics::SValue);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::SymbolicSemantics::MemoryListState);
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::SymbolicSemantics::MemoryIndexedState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::SymbolicSemantics::MemoryMapState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::InstructionSemantics::SymbolicSemantics::RiscOperators);
 #endif
@@ -6,6 +6,7 @@
 #include <Rose/BinaryAnalysis/Partitioner2/BasicTypes.h>
 
 #include <Sawyer/Database.h>
+#include <Sawyer/Map.h>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/SharedPointer.h>
 #include <ctime>
@@ -343,9 +344,23 @@ public:
     std::vector<Function::Ptr> functions(const Library::Ptr&);
     /** @} */
 
-    /** Find database functions that match a given function. */
+    /** Find database functions that match a given function.
+     *
+     *  The return value is sorted by library hash and then function address. */
     std::vector<Function::Ptr> search(const Partitioner2::PartitionerConstPtr &partitioner, const Partitioner2::FunctionPtr&);
 
+    /** Matches for many functions, indexed by the entry address of the specimen function. */
+    using SearchResults = Sawyer::Container::Map<rose_addr_t, std::vector<Function::Ptr>>;
+
+    /** Find database functions that match each of the given functions.
+     *
+     *  This produces the same matches as calling the single-function @ref search for each function, but is much faster when
+     *  there are many functions. The functions are hashed in parallel using the number of threads specified by the global
+     *  "--threads" command-line switch, and then the database is scanned once to build an in-memory index from hash to
+     *  database functions, which is used to resolve all the matches. Only specimen functions that match at least one database
+     *  function appear in the return value. */
+    SearchResults search(const Partitioner2::PartitionerConstPtr &partitioner, const std::vector<Partitioner2::FunctionPtr>&);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Utilities
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
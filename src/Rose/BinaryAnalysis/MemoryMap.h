@@ -7,6 +7,7 @@
 #include <Rose/BinaryAnalysis/ByteOrder.h>
 
 #include <Combinatorics.h>
+#include <Rose/Constants.h>
 #include <Rose/Exception.h>
 
 #include <Sawyer/Access.h>
@@ -612,6 +613,36 @@ public:
      *  is returned. An empty sequence matches at the beginning of the @p interval. */
     Sawyer::Optional<rose_addr_t> findSequence(const AddressInterval &interval, const std::vector<uint8_t> &sequence) const;
 
+    /** Location of a byte sequence found by @ref findSequences. */
+    struct SequenceMatch {
+        rose_addr_t va = 0;                             /**< Address of the first byte of the match. */
+        size_t sequenceIndex = 0;                       /**< Index of the matched sequence in the search argument. */
+
+        SequenceMatch() {}
+        SequenceMatch(rose_addr_t va, size_t sequenceIndex)
+            : va(va), sequenceIndex(sequenceIndex) {}
+
+        /** Order by address, then sequence index. */
+        bool operator<(const SequenceMatch &other) const {
+            return va < other.va || (va == other.va && sequenceIndex < other.sequenceIndex);
+        }
+    };
+
+    /** Search for many byte sequences at once.
+     *
+     *  Finds all occurrences of all of the specified @p sequences that lie entirely within the @p interval and within memory
+     *  that has all the @p requiredPerms and none of the @p prohibitedPerms. A match may span adjacent segments, but not a gap
+     *  in the mapping. Overlapping matches are all reported, and empty sequences never match. The sequences can be any length.
+     *
+     *  The memory is scanned only once regardless of the number of sequences (the sequences are compiled into an Aho-Corasick
+     *  automaton). Segments whose buffers are directly addressable are scanned in place; other segments are read in chunks.
+     *
+     *  The return value is sorted by address and then sequence index. If more than @p maxMatches matches exist, then the
+     *  scan stops after @p maxMatches have been found, which are the ones that end at the lowest addresses. */
+    std::vector<SequenceMatch> findSequences(const AddressInterval &interval, const std::vector<std::vector<uint8_t>> &sequences,
+                                             size_t maxMatches = UNLIMITED, unsigned requiredPerms = 0,
+                                             unsigned prohibitedPerms = 0) const;
+
     /** Prints the contents of the map for debugging. The @p prefix string is added to the beginning of every line of output
      *  and typically is used to indent the output.
      *  @{ */
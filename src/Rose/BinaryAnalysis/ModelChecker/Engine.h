@@ -11,6 +11,7 @@
 #include <Sawyer/Stopwatch.h>
 #include <boost/filesystem.hpp>
 #include <boost/thread/thread.hpp>
+#include <atomic>
 #include <thread>
 
 namespace Rose {
@@ -65,6 +66,7 @@ private:
     PathQueue frontier_;                                // paths with work remaining
     PathQueue interesting_;                             // paths that are interesting, placed here by workers
     SemanticCallbacksPtr semantics_;                    // various configurable semantic operations
+    std::atomic<size_t> nWaitingForWork_;               // number of threads waiting on newWork_ for the frontier to be non-empty
 
 private:
     // Synchronized data members
@@ -78,6 +80,7 @@ private:
     std::vector<std::thread> workers_;                  // managed worker threads
     size_t workCapacity_ = 0;                           // managed workers plus user threads
     size_t nWorking_ = 0;                               // number of threads currently doing work
+    size_t nTaking_ = 0;                                // threads taking from the frontier without holding this lock
     size_t nPathsExplored_ = 0;                         // number of path nodes executed, i.e., number of paths explored
     size_t nStepsExplored_ = 0;                         // number of steps executed
     bool stopping_ = false;                             // when true, workers stop even if there is still work remaining
@@ -34,7 +34,8 @@ struct Settings {
     /** Type of memory state to use. */
     enum class MemoryType {
         LIST,                                           /**< Reverse chronological list. This is more accurate. */
-        MAP                                             /**< Map indexed by symbolic address hash. This is faster. */
+        MAP,                                            /**< Map indexed by symbolic address hash. This is faster. */
+        INDEXED                                         /**< Reverse chronological list indexed by address. */
     };
 
     TestMode nullRead = TestMode::MUST;                 /**< How to test for reads from the null page. */
@@ -5,6 +5,9 @@
 
 #include <Rose/BinaryAnalysis/ModelChecker/Types.h>
 
+#include <atomic>
+#include <memory>
+
 namespace Rose {
 namespace BinaryAnalysis {
 namespace ModelChecker {
@@ -12,9 +15,28 @@ namespace ModelChecker {
 /** List of path endpoints in an execution tree.
  *
  *  A queue of execution tree vertices ordered by some user-defined metric. The metric is defined by the @ref
- *  PathPrioritizer supplied as a constructor argument. */
+ *  PathPrioritizer supplied as a constructor argument.
+ *
+ *  A queue normally has a single shard, in which case it is a true priority queue protected by a single lock. When many
+ *  threads use the queue at the same time that lock can become a bottleneck, so the queue can instead be split into multiple
+ *  shards (see @ref nShards), each of which is a priority queue with its own lock. In that mode each thread inserts into and
+ *  takes from its own "home" shard, and when its home shard is empty it steals the highest priority path from some other
+ *  shard. When taking a path, the home shard's best path is also compared with the best path of one other shard and the
+ *  better of the two is taken, so that the queue as a whole approximates the global priority order without every thread
+ *  contending for the same lock. */
 class PathQueue final {
 public:
+    /** Queue operation statistics.
+     *
+     *  These are counters that describe how the queue was used, either by a single thread (@ref threadStatistics) or by all
+     *  threads for one queue (@ref statistics). */
+    struct Statistics {
+        size_t nInserts = 0;                            /**< Number of paths inserted. */
+        size_t nTakes = 0;                              /**< Number of paths taken, including stolen paths. */
+        size_t nSteals = 0;                             /**< Number of paths taken from a shard other than the home shard. */
+        size_t nContended = 0;                          /**< Number of times a shard lock was already held by another thread. */
+    };
+
     /** Visitor for traversing a queue. */
     class Visitor {
     public:
@@ -28,9 +50,17 @@ public:
     };
 
 private:
-    mutable SAWYER_THREAD_TRAITS::Mutex mutex_;     // protects all following data members
-    PathPrioritizerPtr prioritizer_;
-    std::vector<PathPtr> paths_;
+    // One priority queue. A thread must hold the shard's lock while accessing the shard's paths.
+    struct Shard {
+        mutable SAWYER_THREAD_TRAITS::Mutex mutex;      // protects the paths of this shard
+        std::vector<PathPtr> paths;                     // heap ordered by the prioritizer
+    };
+
+    PathPrioritizerPtr prioritizer_;                    // changed only when all shards are locked
+    std::vector<std::unique_ptr<Shard>> shards_;        // changed only when no other thread is using this queue
+    std::atomic<size_t> size_;                          // total number of paths in all shards
+    std::atomic<size_t> nInserts_, nTakes_, nSteals_; // statistics for all threads
+    mutable std::atomic<size_t> nContended_;            // number of times a shard lock was contended
 
 public:
     PathQueue() = delete;
@@ -57,9 +87,26 @@ public:
     void prioritizer(const PathPrioritizerPtr&);
     /** @} */
 
+    /** Property: Number of shards.
+     *
+     *  A queue has one or more shards, each of which is an independently locked priority queue. Having only one shard (the
+     *  default) makes this a true priority queue. Having more than one shard reduces lock contention when many threads use the
+     *  queue concurrently, but then paths are taken in only an approximation of the priority order. Changing the number of
+     *  shards redistributes any existing paths among the new shards. Setting the number of shards to zero is the same as
+     *  setting it to one.
+     *
+     *  Thread safety: The getter is thread safe. The setter is not thread safe: no other thread may be using this queue while
+     *  the number of shards is being changed.
+     *
+     *  @{ */
+    size_t nShards() const;
+    void nShards(size_t);
+    /** @} */
+
     /** Property: Size of queue.
      *
-     *  This returns the number of paths in this queue.
+     *  This returns the number of paths in this queue. If other threads are modifying the queue concurrently, then the
+     *  returned value is only a snapshot.
      *
      *  Thread safety: This method is thread safe. */
     size_t size() const;
@@ -80,7 +127,8 @@ public:
 
     /** Insert a path.
      *
-     *  Insert a path into this queue. The path must not already be a member of the queue.
+     *  Insert a path into this queue. The path must not already be a member of the queue. If the queue has more than one
+     *  shard, then the path is inserted into the calling thread's home shard.
      *
      *  Thread safety: This method is thread safe. */
     void insert(const PathPtr&);
@@ -91,6 +139,10 @@ public:
      *  in the constructor. If this queue is empty, then a null pointer is returned. The returned path is removed from this
      *  queue.
      *
+     *  If this queue has more than one shard, then the returned path is the better of the best path from the calling thread's
+     *  home shard and the best path from one other shard. If the home shard is empty, then the best path is stolen from some
+     *  other shard. A null pointer is returned only if all shards are empty.
+     *
      *  Thread safety: This method is thread safe. */
     PathPtr takeNext();
 
@@ -101,6 +153,33 @@ public:
      *
      *  Thread safety: This method is thread safe. The queue is locked for the duration of the traversal. */
     void traverse(Visitor&) const;
+
+    /** Statistics for this queue.
+     *
+     *  Returns the statistics accumulated over all threads since this queue was created or last @ref reset.
+     *
+     *  Thread safety: This method is thread safe. */
+    Statistics statistics() const;
+
+    /** Statistics for the calling thread.
+     *
+     *  Returns the statistics accumulated by the calling thread over all queues since the thread started.
+     *
+     *  Thread safety: This method is thread safe. */
+    static Statistics threadStatistics();
+
+private:
+    // Index of the calling thread's home shard.
+    size_t homeShard() const;
+
+    // Lock a shard, counting contention if the lock is already held.
+    void lockShard(const Shard&) const;
+
+    // Remove and return the best path from a locked, non-empty shard.
+    PathPtr popShard(Shard&);
+
+    // Compare paths according to the prioritizer. Returns true if @p a has lower priority than @p b.
+    bool lessPriority(const PathPtr &a, const PathPtr &b) const;
 };
 
 } // namespace
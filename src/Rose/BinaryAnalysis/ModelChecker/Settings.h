@@ -31,6 +31,7 @@ public:
     SourceListerPtr sourceLister;                       /**< Object responsible for listing lines of a source code file. */
     uint64_t maxSymbolicSize = 0;                       /**< If nonzero, maximum size of symbolic expressions. */
     bool exploreDuplicateStates = true;                 /**< Look for duplicate states and suppress them? */
+    bool workStealing = false;                          /**< Give each worker its own work queue and steal when empty? */
 
 public:
     Settings();
@@ -3,6 +3,7 @@
 #include <featureTests.h>
 #ifdef ROSE_ENABLE_MODEL_CHECKER
 
+#include <Rose/BinaryAnalysis/ModelChecker/PathQueue.h>
 #include <Rose/BinaryAnalysis/ModelChecker/Types.h>
 
 #include <Rose/Progress.h>
@@ -27,6 +28,7 @@ private:
         time_t stateChange = 0;                         // time of last state change
         Progress::Ptr progress;                         // progress reports
         uint64_t pathHash = 0;                          // if working, the current path
+        PathQueue::Statistics queueStats;               // work queue usage by this worker
     };
 
     std::vector<Status> workers_;
@@ -56,6 +58,12 @@ public:
      *  The path hash must be non-zero when the WorkerState is WORKING, and zero otherwise. */
     void setState(size_t workerIdx, WorkerState, uint64_t pathHash);
 
+    /** Update the work queue statistics for a worker.
+     *
+     *  The statistics are those returned by @ref PathQueue::threadStatistics for the worker's thread, and are shown in the
+     *  file along with the worker states. */
+    void setQueueStatistics(size_t workerIdx, const PathQueue::Statistics&);
+
     /** Name of file to which status is written. */
     const boost::filesystem::path& fileName() const;
 
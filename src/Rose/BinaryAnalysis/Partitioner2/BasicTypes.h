@@ -86,7 +86,8 @@ enum Confidence {
 /** Organization of semantic memory. */
 enum SemanticMemoryParadigm {
     LIST_BASED_MEMORY,                                  /**< Precise but slow. */
-    MAP_BASED_MEMORY                                    /**< Fast but not precise. */
+    MAP_BASED_MEMORY,                                   /**< Fast but not precise. */
+    INDEXED_MEMORY                                      /**< Precise like list-based, but indexed by address. */
 };
 
 /** Settings that control building the AST.
@@ -259,6 +260,12 @@ struct LoaderSettings {
      *  libraries). These substitutions are escaped using Bourne shell syntax and thus should not be quoted. */
     std::string linker = "ld -o %o --unresolved-symbols=ignore-all --whole-archive %f";
 
+    /** Whether to map container files into memory.
+     *
+     *  If set, container files (ELF, PE, etc.) are mapped into memory rather than read, and the memory segments created for them
+     *  by the loader share the mapping. See @c SgAsmGenericFile::set_map_content. */
+    bool mapContainerFiles = false;
+
     /** Names to erase from the environment.
      *
      *  This property is a list of environment variable names that will be removed before launching a "run:" style specimen.
@@ -411,6 +418,15 @@ struct PartitionerSettings {
      *  addition to entry addresses, addresses from symbols, addresses from configuration files, etc. */
     std::vector<rose_addr_t> functionStartingVas;
 
+    /** Whether to discover instructions in parallel.
+     *
+     *  If set, the recursive partitioning phase first discovers instructions and control flow using the multi-threaded
+     *  @ref Experimental::ParallelPartitioner::Partitioner, starting from the functions found so far, and then transfers the
+     *  resulting basic blocks and functions into the usual partitioner. The serial discovery that follows has little left to
+     *  do. The number of threads is controlled by the "--threads" command-line switch. Basic block callbacks are not invoked
+     *  for blocks that are discovered in parallel. */
+    bool parallelDiscovery = false;
+
     /** Whether to follow ghost edges.
      *
      *  A "ghost edge" is a control flow graph (CFG) edge that would be present if the CFG-building analysis looked only at
@@ -736,6 +752,8 @@ private:
             if (S::is_loading::value)
                 syscallHeader = temp;
         }
+        if (version >= 9)
+            s & BOOST_SERIALIZATION_NVP(parallelDiscovery);
     }
 };
 
@@ -846,7 +864,7 @@ using ThunkPredicatesPtr = Sawyer::SharedPointer<ThunkPredicates>; /**< Shared-o
 } // namespace
 
 // Class versions must be at global scope
-BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 8);
+BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 9);
 BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::BasePartitionerSettings, 1);
 BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::LoaderSettings, 1);
 BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::DisassemblerSettings, 1);
@@ -545,6 +545,15 @@ public:
      *  attachBlocksToFunctions tries to attach each basic block to a function. */
     virtual void discoverFunctions(const PartitionerPtr&);
 
+    /** Discover instructions and basic blocks in parallel.
+     *
+     *  Runs a multi-threaded @ref Experimental::ParallelPartitioner::Partitioner starting at the partitioner's existing
+     *  functions and basic block placeholders, and transfers its basic blocks and functions into the specified partitioner,
+     *  which updates its control flow graph and address usage map. This is repeated for function prologues found in the
+     *  memory that's still unused. This is called by @ref runPartitionerRecursive before @ref discoverFunctions when the @c
+     *  parallelDiscovery setting is enabled. */
+    virtual void discoverFunctionsInParallel(const PartitionerPtr&);
+
     /** Attach dead code to function.
      *
      *  Examines the ghost edges for the basic blocks that belong to the specified function in order to discover basic blocks
@@ -1048,8 +1048,10 @@ public:
 
     /** Build results from CFG.
      *
-     *  Clears and repopulates the specified partitioner object with information from this partitioner's global control flow
-     *  graph.
+     *  Populates the specified partitioner object with information from this partitioner's global control flow graph. The
+     *  partitioner need not be empty: basic blocks whose first instruction it already has are not transferred, and other
+     *  blocks are cut short where they reach one of its existing instructions, so this can be called once for each of
+     *  several parallel partitioners that feed the same serial partitioner.
      *
      *  Thread safety: This function is not thread safe. */
     void transferResults(const Rose::BinaryAnalysis::Partitioner2::PartitionerPtr &out);
@@ -19,12 +19,14 @@
 #include <Sawyer/Attribute.h>
 #include <Sawyer/Callbacks.h>
 #include <Sawyer/IntervalSet.h>
+#include <Sawyer/IntervalSetMap.h>
 #include <Sawyer/Map.h>
 #include <Sawyer/Message.h>
 #include <Sawyer/Optional.h>
 #include <Sawyer/ProgressBar.h>
 #include <Sawyer/SharedObject.h>
 #include <Sawyer/SharedPointer.h>
+#include <Sawyer/Set.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
@@ -376,6 +378,18 @@ private:
     Progress::Ptr progress_;                            // Progress reporter to update, or null
     mutable size_t cfgProgressTotal_;                   // Expected total for the CFG progress bar; initialized at first report
 
+    // Parts of a partitioner that are loaded on demand from an indexed RBA file. The maps hold the table of contents entries
+    // of the parts that have not been materialized yet, and the input is released once everything has been materialized.
+    typedef Sawyer::Container::Map<rose_addr_t, SerialIo::Chunk> LazyChunks;
+    typedef Sawyer::Container::IntervalSetMap<AddressInterval, Sawyer::Container::Set<rose_addr_t> > LazyBlockExtents;
+    SerialInputPtr lazyInput_;                          // file from which parts are materialized, or null
+    LazyChunks lazyFunctions_;                          // functions by entry address
+    LazyChunks lazyBasicBlocks_;                        // basic blocks by starting address
+    LazyBlockExtents lazyBlockExtents_;                 // starting addresses of lazy basic blocks by instruction address
+    LazyChunks lazyInstructions_;                       // instructions that belong to no basic block, by address
+    Sawyer::Optional<SerialIo::Chunk> lazyInterpretation_; // the interpretation AST
+    mutable bool materializing_;                        // a part is being materialized, so queries must not materialize more
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //
@@ -388,7 +402,7 @@ private:
     friend class boost::serialization::access;
 
     template<class S>
-    void serializeCommon(S &s, const unsigned version) {
+    static void registerSerializationTypes(S &s) {
         s.template register_type<InstructionSemantics::SymbolicSemantics::SValue>();
         s.template register_type<InstructionSemantics::SymbolicSemantics::RiscOperators>();
 #ifdef ROSE_ENABLE_ASM_AARCH64
@@ -409,6 +423,11 @@ private:
         s.template register_type<Semantics::RegisterState>();
         s.template register_type<Semantics::State>();
         s.template register_type<Semantics::RiscOperators>();
+    }
+
+    template<class S>
+    void serializeCommon(S &s, const unsigned version) {
+        registerSerializationTypes(s);
         s & BOOST_SERIALIZATION_NVP(settings_);
         // s & config_;                         -- FIXME[Robb P Matzke 2016-11-08]
         s & BOOST_SERIALIZATION_NVP(instructionProvider_);
@@ -437,8 +456,76 @@ private:
             s & BOOST_SERIALIZATION_NVP(elfGotVa_);
         // s & progress_;                       -- not saved/restored
         // s & cfgProgressTotal_;               -- not saved/restored
+        // s & lazyInput_ etc.                  -- not saved/restored
     }
 
+    // The parts of a partitioner that are saved in the partitioner chunk of an indexed RBA file. The functions, basic blocks,
+    // instructions, and interpretation are saved in chunks of their own, and the CFG and AUM are rebuilt as they're attached.
+    template<class S>
+    void serializeSkeleton(S &s, std::vector<rose_addr_t> &placeholders) {
+        registerSerializationTypes(s);
+        s & BOOST_SERIALIZATION_NVP(settings_);
+
+        // The instructions are saved with their basic blocks or in chunks of their own, not in the instruction provider.
+        InstructionProvider::Ptr instructionProvider = instructionProvider_;
+        if (S::is_saving::value) {
+            instructionProvider = InstructionProvider::instance(instructionProvider_->disassembler(), memoryMap_);
+            instructionProvider->enableDisassembler(instructionProvider_->isDisassemblerEnabled());
+        }
+        s & boost::serialization::make_nvp("instructionProvider_", instructionProvider);
+        if (S::is_loading::value)
+            instructionProvider_ = instructionProvider;
+
+        s & BOOST_SERIALIZATION_NVP(memoryMap_);
+        s & BOOST_SERIALIZATION_NVP(autoAddCallReturnEdges_);
+        s & BOOST_SERIALIZATION_NVP(assumeFunctionsReturn_);
+        s & BOOST_SERIALIZATION_NVP(stackDeltaInterproceduralLimit_);
+        s & BOOST_SERIALIZATION_NVP(addressNames_);
+        s & BOOST_SERIALIZATION_NVP(sourceLocations_);
+        s & BOOST_SERIALIZATION_NVP(semanticMemoryParadigm_);
+        s & BOOST_SERIALIZATION_NVP(elfGotVa_);
+        s & BOOST_SERIALIZATION_NVP(placeholders);
+    }
+
+    // Serialization wrapper for the partitioner chunk of an indexed RBA file.
+    struct RbaSkeleton {
+        Partitioner *partitioner;
+        std::vector<rose_addr_t> placeholders;          // CFG placeholders that have no basic block
+
+        explicit RbaSkeleton(Partitioner *partitioner)
+            : partitioner(partitioner) {}
+
+        template<class S>
+        void serialize(S &s, const unsigned /*version*/) {
+            partitioner->serializeSkeleton(s, placeholders);
+        }
+    };
+
+    // Serialization wrapper for a function, basic block, instruction, or interpretation chunk of an indexed RBA file.
+    template<class T>
+    struct RbaPart {
+        T &object;
+
+        explicit RbaPart(T &object)
+            : object(object) {}
+
+        template<class S>
+        void serialize(S &s, const unsigned /*version*/) {
+            registerSerializationTypes(s);
+            transfer(s, object);
+        }
+
+        template<class S, class U>
+        static void transfer(S &s, U &object) {
+            s & BOOST_SERIALIZATION_NVP(object);
+        }
+
+        template<class S, class U>
+        static void transfer(S &s, U* &ast) {
+            transferAst(s, ast);
+        }
+    };
+
     template<class S>
     void save(S &s, const unsigned version) const {
         const_cast<Partitioner*>(this)->serializeCommon(s, version);
@@ -460,6 +547,35 @@ private:
     BOOST_SERIALIZATION_SPLIT_MEMBER();
 #endif
 
+private:
+    // Indexed RBA files are split into chunks by the partitioner, which knows what the chunks are.
+    friend class BinaryAnalysis::SerialOutput;
+    friend class BinaryAnalysis::SerialInput;
+
+    // Save this partitioner as a sequence of chunks of an indexed RBA file.
+    void saveChunks(SerialOutput&) const;
+
+    // Load the partitioner chunk at the specified index of the table of contents and arrange for the chunks that follow it to
+    // be loaded on demand.
+    void loadChunks(const SerialInputPtr&, size_t tocIndex);
+
+    // Release the RBA file once nothing remains to be materialized.
+    void releaseLazyInput();
+
+    // A data block loaded from a chunk still lists its owners from when it was saved, which are copies of the real ones.
+    void forgetDataBlockOwners(const DataBlockPtr&);
+
+    // Materialize the parts of a lazy partitioner that a query needs in order to give the same answer it would have given if
+    // the partitioner had been loaded all at once. The "Graph" parts are all functions and basic blocks, which are needed by
+    // queries about the CFG and AUM as a whole. These do nothing while a part is being materialized.
+    void materializeFunctionsForQuery() const;
+    void materializeGraphForQuery() const;
+    void materializeInstructionsForQuery() const;
+    void materializeFunctionForQuery(rose_addr_t entryVa) const;
+    void materializeBasicBlockForQuery(rose_addr_t startVa) const;
+    void materializeInstructionForQuery(rose_addr_t va) const;
+    void materializeInterpretationForQuery() const;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //
@@ -498,6 +614,64 @@ public:
     /** Save this partitioner as an RBA file. */
     void saveAsRbaFile(const boost::filesystem::path &name, SerialIo::Format fmt) const;
 
+    /** Construct a partitioner that loads its functions and basic blocks on demand.
+     *
+     *  The RBA file must have been saved in the @ref SerialIo::INDEXED format. Only the partitioner's settings, memory map,
+     *  address names, and similar small data are read by this function. The functions, basic blocks, instructions, and
+     *  interpretation remain in the file until they're requested, at which time they're read and attached to this partitioner.
+     *  They can be requested explicitly with the "materialize" functions, such as @ref materializeFunction. Queries also
+     *  materialize whatever they need in order to answer as if the whole partitioner had been loaded: @ref functionExists
+     *  loads only the one function, @ref functions loads all functions, and queries about the CFG or AUM as a whole, such as
+     *  @ref cfg and @ref aum, load all functions and basic blocks. Therefore tools that need only some parts pay only for those
+     *  parts.
+     *
+     *  The file remains open until everything has been materialized or the partitioner is destroyed. A partitioner that still
+     *  has parts in the file can neither be modified nor saved.
+     *
+     *  Thread safety: Not thread safe. */
+    static PartitionerPtr lazyInstanceFromRbaFile(const boost::filesystem::path&);
+
+    /** Whether parts of this partitioner are still in its RBA file.
+     *
+     *  Returns true if this partitioner was created by @ref lazyInstanceFromRbaFile and some of its functions, basic blocks,
+     *  instructions, or its interpretation have not been materialized yet. */
+    bool isLazy() const;
+
+    /** Table of contents entries for functions that are still in the RBA file.
+     *
+     *  Returns the entries, sorted by entry address, for the functions that have not been materialized yet. Each entry has the
+     *  function's entry address and name, which is enough to list the functions without loading them. */
+    std::vector<SerialIo::Chunk> lazyFunctions() const;
+
+    /** Load a function on demand.
+     *
+     *  Returns the function whose entry address is @p entryVa. If the function has not been materialized yet then it and all its
+     *  basic blocks are read from the RBA file and attached to this partitioner. Returns null if there is no such function. */
+    FunctionPtr materializeFunction(rose_addr_t entryVa);
+
+    /** Load a basic block on demand.
+     *
+     *  Returns the basic block that starts at @p startVa, reading it from the RBA file and attaching it if necessary. Returns
+     *  null if there is no such basic block. */
+    BasicBlockPtr materializeBasicBlock(rose_addr_t startVa);
+
+    /** Load an instruction on demand.
+     *
+     *  Materializes the basic blocks that contain the specified address, or the instruction itself if it belongs to no basic
+     *  block, and then returns the instruction at that address from the instruction provider. */
+    SgAsmInstruction* materializeInstruction(rose_addr_t va);
+
+    /** Load the interpretation on demand.
+     *
+     *  Reads the interpretation AST from the RBA file if necessary and returns it. */
+    SgAsmInterpretation* materializeInterpretation();
+
+    /** Load everything on demand.
+     *
+     *  Materializes all functions, basic blocks, instructions, and the interpretation that are still in the RBA file and then
+     *  closes the file. */
+    void materializeAll();
+
 #ifdef ROSE_PARTITIONER_MOVE
     /** Move constructor. */
     Partitioner(BOOST_RV_REF(Partitioner));
@@ -2533,10 +2707,10 @@ public:
 
     /** Obtain new RiscOperators.
      *
-     *  Creates a new instruction semantics infrastructure with a fresh machine state.  The partitioner supports two kinds of
-     *  memory state representations: list-based and map-based (see @ref semanticMemoryParadigm). If the memory paradigm is not
-     *  specified then the partitioner's default paradigm is used. Returns a null pointer if the architecture does not support
-     *  semantics.
+     *  Creates a new instruction semantics infrastructure with a fresh machine state.  The partitioner supports three kinds of
+     *  memory state representations: list-based, map-based, and indexed (see @ref semanticMemoryParadigm). If the memory
+     *  paradigm is not specified then the partitioner's default paradigm is used. Returns a null pointer if the architecture
+     *  does not support semantics.
      *
      *  Thread safety: Not thread safe.
      *
@@ -200,12 +200,18 @@ typedef MemoryState<InstructionSemantics::SymbolicSemantics::MemoryListState> Me
 /** Memory state indexed by hash of address expressions. */
 typedef MemoryState<InstructionSemantics::SymbolicSemantics::MemoryMapState> MemoryMapState;
 
+/** Memory state using a chronological list of cells that is also indexed by address. */
+typedef MemoryState<InstructionSemantics::SymbolicSemantics::MemoryIndexedState> MemoryIndexedState;
+
 /** Shared-ownership pointer to a @ref MemoryListState. See @ref heap_object_shared_ownership. */
 typedef boost::shared_ptr<MemoryListState> MemoryListStatePtr;
 
 /** Shared-ownership pointer to a @ref MemoryMapState. See @ref heap_object_shared_ownership. */
 typedef boost::shared_ptr<MemoryMapState> MemoryMapStatePtr;
 
+/** Shared-ownership pointer to a @ref MemoryIndexedState. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<MemoryIndexedState> MemoryIndexedStatePtr;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      RISC Operators
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -395,6 +401,7 @@ MemoryState<Super>::print(std::ostream &out, InstructionSemantics::BaseSemantics
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryListState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryMapState);
+BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::MemoryIndexedState);
 BOOST_CLASS_EXPORT_KEY(Rose::BinaryAnalysis::Partitioner2::Semantics::RiscOperators);
 #endif
 
@@ -35,6 +35,9 @@
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <sstream>
 #endif
 
 #include <Rose/Progress.h>
@@ -61,7 +64,8 @@ namespace BinaryAnalysis {
  *
  *  The file in which the state is stored is accessed sequentially, making it suitable to send output to a stream or read
  *  from a stream.  This also means that most of the interface for these objects has no need to be thread-safe, although
- *  the progress-reporting part of the API is thread-safe.
+ *  the progress-reporting part of the API is thread-safe. The exception is the @ref INDEXED format, which must be read from a
+ *  seekable file but whose individual chunks can then be read in any order.
  *
  *  As objects are written to the output stream, they are each preceded by a object type identifier. These integer type
  *  identifiers are available when reading from the stream in order to decide which type of object to read next.
@@ -121,19 +125,56 @@ public:
         TEXT,           /**< Textual binary state files use a custom format (Boost serialization format) that stores the
                          *   data as ASCII text. They are larger and slower than binary files but not as large and slow
                          *   as XML or JSON files. They are portable across architectures. */
-        XML             /**< The states are stored as XML, which is a very verbose and slow format. Avoid using this if
+        XML,            /**< The states are stored as XML, which is a very verbose and slow format. Avoid using this if
                          *   possible. */
+        INDEXED         /**< The file is a sequence of separately addressable chunks followed by a table of contents. Each chunk
+                         *   uses the same encoding as @ref BINARY files. A saved partitioner is split so that each of its
+                         *   functions, basic blocks, and instructions is a chunk of its own, which allows the partitioner to be
+                         *   loaded lazily (see @ref Partitioner2::Partitioner::lazyInstanceFromRbaFile). Indexed files can be
+                         *   written to a pipe, but they can be read only from a seekable file. */
     };
 
     /** Types of objects that can be saved. */
     enum Savable {
-        NO_OBJECT           = 0x00000000, /**< Object type for newly-initialized serializers. */
-        PARTITIONER         = 0x00000001, /**< Rose::BinaryAnalysis::Partitioner2::Partitioner. */
-        AST                 = 0x00000002, /**< Abstract syntax tree. */
-        END_OF_DATA         = 0x0000fffe, /**< Marks the end of the data stream. */
-        ERROR               = 0x0000ffff, /**< Marks that the stream has encountered an error condition. */
-        USER_DEFINED        = 0x00010000, /**< First user-defined object number. */
-        USER_DEFINED_LAST   = 0xffffffff  /**< Last user-defined object number. */
+        NO_OBJECT            = 0x00000000, /**< Object type for newly-initialized serializers. */
+        PARTITIONER          = 0x00000001, /**< Rose::BinaryAnalysis::Partitioner2::Partitioner. */
+        AST                  = 0x00000002, /**< Abstract syntax tree. */
+        BASIC_BLOCK_CHUNK    = 0x00000003, /**< One basic block of a partitioner in an @ref INDEXED file. */
+        FUNCTION_CHUNK       = 0x00000004, /**< One function of a partitioner in an @ref INDEXED file. */
+        INSTRUCTION_CHUNK    = 0x00000005, /**< One instruction that belongs to no basic block in an @ref INDEXED file. */
+        INTERPRETATION_CHUNK = 0x00000006, /**< The interpretation AST of a partitioner in an @ref INDEXED file. */
+        END_OF_DATA          = 0x0000fffe, /**< Marks the end of the data stream. */
+        ERROR                = 0x0000ffff, /**< Marks that the stream has encountered an error condition. */
+        USER_DEFINED         = 0x00010000, /**< First user-defined object number. */
+        USER_DEFINED_LAST    = 0xffffffff  /**< Last user-defined object number. */
+    };
+
+    /** Table of contents entry for an @ref INDEXED file.
+     *
+     *  Each entry describes one chunk of the file. Chunks whose type is one of the "_CHUNK" @ref Savable constants are parts of
+     *  the partitioner that precedes them and are skipped when objects are read sequentially. */
+    struct Chunk {
+        Savable objectType = NO_OBJECT;                 /**< Type of object stored in the chunk. */
+        rose_addr_t address = 0;                        /**< Starting address of the function, basic block, or instruction. */
+        AddressInterval extent;                         /**< Addresses of a basic block's or instruction's bytes. */
+        std::string name;                               /**< Name of a function. */
+        uint64_t offset = 0;                            /**< Byte offset of the chunk from the beginning of the file. */
+        uint64_t size = 0;                              /**< Size of the chunk in bytes. */
+
+#ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
+    private:
+        friend class boost::serialization::access;
+
+        template<class S>
+        void serialize(S &s, const unsigned /*version*/) {
+            s & BOOST_SERIALIZATION_NVP(objectType);
+            s & BOOST_SERIALIZATION_NVP(address);
+            s & BOOST_SERIALIZATION_NVP(extent);
+            s & BOOST_SERIALIZATION_NVP(name);
+            s & BOOST_SERIALIZATION_NVP(offset);
+            s & BOOST_SERIALIZATION_NVP(size);
+        }
+#endif
     };
 
     /** Errors thrown by this API. */
@@ -246,6 +287,11 @@ public:
      *  an output stream, it's the type of the object that was last written. */
     Savable objectType() const;
 
+    /** Whether an object type is part of a partitioner in an @ref INDEXED file.
+     *
+     *  Returns true for the "_CHUNK" constants, which are never returned by @ref objectType. */
+    static bool isPartitionerChunk(Savable);
+
 protected:
     // Set or clear the isOpen flag.
     void setIsOpen(bool b);
@@ -277,11 +323,13 @@ private:
     boost::archive::binary_oarchive *binary_archive_;
     boost::archive::text_oarchive *text_archive_;
     boost::archive::xml_oarchive *xml_archive_;
+    uint64_t nWritten_;                                 // bytes written to an INDEXED file so far
+    std::vector<Chunk> toc_;                            // table of contents for an INDEXED file
 #endif
 
 protected:
 #ifdef ROSE_SUPPORTS_SERIAL_IO
-    SerialOutput(): binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL) {}
+    SerialOutput(): binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL), nWritten_(0) {}
 #else
     SerialOutput() {}
 #endif
@@ -302,6 +350,9 @@ public:
      *  The specified partitioner, including all data reachable from the partitioner such as specimen data, instruction
      *  ASTs, and analysis results, is written to the attached file.
      *
+     *  If the format is @ref INDEXED then the partitioner's functions, basic blocks, instructions, and interpretation are each
+     *  written to chunks of their own following a chunk that has the rest of the partitioner.
+     *
      *  Throws an @ref Exception if the partitioner cannot be saved.
      *
      *  Thread safety: This method is not thread-safe. No other thread should be using this object, and no other thread
@@ -375,7 +426,40 @@ public:
 #endif
     }
 
+    /** Save an object as one chunk of an @ref INDEXED file.
+     *
+     *  The object is written to the output as a chunk of its own and the @p chunk description, updated with the chunk's
+     *  location, is added to the table of contents that's written when the file is closed. Most users should call @ref
+     *  saveObject instead, which also calls this function when the format is @ref INDEXED.
+     *
+     *  Throws an @ref Exception if the format is not @ref INDEXED or the object cannot be saved. */
+    template<class T>
+    void saveChunk(Chunk chunk, const T &object) {
+        if (!isOpen())
+            throw Exception("cannot save chunk when no file is open");
+        if (format() != INDEXED)
+            throw Exception("chunks can be saved only in indexed files");
+#ifndef ROSE_SUPPORTS_SERIAL_IO
+        throw Exception("binary state files are not supported in this configuration");
+#else
+        std::ostringstream ss;
+        {
+            boost::archive::binary_oarchive archive(ss);
+            std::string roseVersion = ROSE_PACKAGE_VERSION;
+            archive <<BOOST_SERIALIZATION_NVP(roseVersion);
+            archive <<BOOST_SERIALIZATION_NVP(object);
+        }
+        writeChunk(chunk, ss.str());
+#endif
+    }
+
 private:
+    // Write the bytes of one chunk to an INDEXED file and add it to the table of contents.
+    void writeChunk(Chunk&, const std::string &bytes);
+
+    // Write raw bytes to the file.
+    void writeBytes(const std::string&);
+
     template<class T>
     static void startWorker(SerialOutput *saver, Savable objectTypeId, const T *object, std::string *errorMessage) {
         ASSERT_not_null(object);
@@ -413,6 +497,12 @@ private:
                     *xml_archive_ <<BOOST_SERIALIZATION_NVP(roseVersion);
                     *xml_archive_ <<BOOST_SERIALIZATION_NVP(object);
                     break;
+                case INDEXED: {
+                    Chunk chunk;
+                    chunk.objectType = objectTypeId;
+                    saveChunk(chunk, object);
+                    break;
+                }
             }
             objectType(objectTypeId);
 #if !defined(ROSE_DEBUG_SERIAL_IO)
@@ -447,11 +537,13 @@ private:
     boost::archive::binary_iarchive *binary_archive_;
     boost::archive::text_iarchive *text_archive_;
     boost::archive::xml_iarchive *xml_archive_;
+    std::vector<Chunk> toc_;                            // table of contents for an INDEXED file
+    size_t tocCursor_;                                  // index of the chunk for the next object in an INDEXED file
 #endif
 
 protected:
 #ifdef ROSE_SUPPORTS_SERIAL_IO
-    SerialInput(): fileSize_(0), binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL) {}
+    SerialInput(): fileSize_(0), binary_archive_(NULL), text_archive_(NULL), xml_archive_(NULL), tocCursor_(0) {}
 #else
     SerialInput() {}
 #endif
@@ -478,7 +570,8 @@ public:
 
     /** Load a partitioner from the input stream.
      *
-     *  Initializes the specified partitioner with data from the input stream.
+     *  Initializes the specified partitioner with data from the input stream. If the format is @ref INDEXED then all the
+     *  partitioner's chunks are loaded; see @ref Partitioner2::Partitioner::lazyInstanceFromRbaFile for loading them on demand.
      *
      *  Throws an @ref Exception if no file is attached to this I/O object or if the next object to be read from the
      *  input is not a partitioner, or if any other errors occur while reading the partitioner. */
@@ -546,8 +639,47 @@ public:
 #endif
     }
     /** @} */
-        
+
+    /** Table of contents of an @ref INDEXED file.
+     *
+     *  Returns the descriptions of all chunks in the file, in the order they were written. The table of contents is empty if the
+     *  file is not in the @ref INDEXED format. */
+    const std::vector<Chunk>& tableOfContents() const;
+
+    /** Load one chunk of an @ref INDEXED file.
+     *
+     *  The object stored in the specified chunk is read into @p object. Chunks can be loaded in any order and any number of
+     *  times, and loading a chunk doesn't change which object is read next by @ref loadObject. Objects shared by different
+     *  chunks are not shared after loading since each chunk is self contained.
+     *
+     *  Throws an @ref Exception if the format is not @ref INDEXED or the chunk cannot be read.
+     *
+     *  Thread safety: This method is not thread safe. */
+    template<class T>
+    void loadChunk(const Chunk &chunk, T &object) {
+        if (!isOpen())
+            throw Exception("cannot load chunk when no file is open");
+        if (format() != INDEXED)
+            throw Exception("chunks can be loaded only from indexed files");
+#ifndef ROSE_SUPPORTS_SERIAL_IO
+        throw Exception("binary state files are not supported in this configuration");
+#else
+        std::istringstream ss(readChunk(chunk));
+        boost::archive::binary_iarchive archive(ss);
+        std::string roseVersion;
+        archive >>BOOST_SERIALIZATION_NVP(roseVersion);
+        checkCompatibility(roseVersion);
+        archive >>BOOST_SERIALIZATION_NVP(object);
+#endif
+    }
+
 private:
+    // Read the bytes of one chunk of an INDEXED file.
+    std::string readChunk(const Chunk&);
+
+    // Read the table of contents of an INDEXED file.
+    void readTableOfContents(const boost::filesystem::path&);
+
     template<class T>
     static void startWorker(SerialInput *loader, T *object, std::string *errorMessage) {
         loader->asyncLoad(*object, errorMessage);
@@ -583,6 +715,10 @@ private:
                     checkCompatibility(roseVersion);
                     *xml_archive_ >>BOOST_SERIALIZATION_NVP(object);
                     break;
+                case INDEXED:
+                    ASSERT_require(tocCursor_ < toc_.size());
+                    loadChunk(toc_[tocCursor_++], object);
+                    break;
             }
 #if !defined(ROSE_DEBUG_SERIAL_IO)
         } catch (const Exception &e) {
@@ -0,0 +1,138 @@
+#ifndef ROSE_BinaryAnalysis_SmtDatabaseMemoizer_H
+#define ROSE_BinaryAnalysis_SmtDatabaseMemoizer_H
+#include <featureTests.h>
+#ifdef ROSE_ENABLE_SMT_MEMOIZATION_DATABASE
+
+#include <Rose/BinaryAnalysis/SmtSolver.h>
+
+#include <Sawyer/Database.h>
+#include <iostream>
+#include <string>
+
+namespace Rose {
+namespace BinaryAnalysis {
+
+/** SMT solver memoizer that persists its results in a database.
+ *
+ *  This memoizer works like its @ref SmtSolver::Memoizer base class, which it uses as a fast in-memory cache, but it also
+ *  stores every definite result (satisfiable or unsatisfiable) in an SQLite or PostgreSQL database so that the results are
+ *  available to later runs of the same or different tools, and to other processes that are running concurrently. Results that
+ *  the solver could not determine (e.g., because of a timeout) are cached only in memory since they depend on the solver
+ *  settings of the current run.
+ *
+ *  The database is identified by a URL as documented by @c Sawyer::Database::Connection::uriDocString. The tables are
+ *  created if they don't exist, therefore multiple processes can name the same database. SQLite databases are placed in
+ *  write-ahead-log mode so that readers don't block the writer.
+ *
+ *  The database holds a bounded number of records. Each time a record is used its "last used" time is updated, and when the
+ *  number of records exceeds the limit, the least recently used records are deleted.
+ *
+ *  Each run (i.e., each instance of this class) also stores a record of its own statistics in the database, which is updated
+ *  periodically and when the memoizer is destroyed.
+ *
+ *  Database errors are not fatal: they are reported to the @ref SmtSolver::mlog diagnostic stream and the memoizer then
+ *  continues to operate with only its in-memory cache.
+ *
+ *  Thread safety: All methods are thread safe. */
+class SmtDatabaseMemoizer: public SmtSolver::Memoizer {
+public:
+    /** Reference counting pointer. */
+    using Ptr = Sawyer::SharedPointer<SmtDatabaseMemoizer>;
+
+    using ExprList = SmtSolver::ExprList;               /**< List of assertions. */
+    using ExprExprMap = SmtSolver::ExprExprMap;         /**< Evidence of satisfiability. */
+    using Satisfiable = SmtSolver::Satisfiable;         /**< Result of a satisfiability check. */
+
+    /** Statistics for one run. */
+    struct Stats {
+        size_t nLookups = 0;                            /**< Number of calls to @ref find. */
+        size_t nMemoryHits = 0;                         /**< Number of lookups satisfied by the in-memory cache. */
+        size_t nDatabaseHits = 0;                       /**< Number of lookups satisfied by the database. */
+        size_t nInserts = 0;                            /**< Number of records written to the database. */
+        size_t nEvictions = 0;                          /**< Number of records evicted from the database by this run. */
+        size_t nErrors = 0;                             /**< Number of database errors. */
+
+        /** Number of lookups that were cache hits. */
+        size_t memoizationHits() const {
+            return nMemoryHits + nDatabaseHits;
+        }
+
+        /** Print statistics. */
+        void print(std::ostream&, const std::string &prefix = "") const;
+    };
+
+private:
+    std::string url_;                                   // database that was opened
+    size_t maxRecords_ = 0;                             // maximum number of records in the database, zero means no limit
+    std::string runKey_;                                // unique name for this run in the runs table
+
+    mutable SAWYER_THREAD_TRAITS::Mutex dbMutex_;       // protects the following data members
+    mutable Sawyer::Database::Connection db_;           // not open if there was an error
+    Stats stats_;                                       // statistics for this run
+    size_t nInsertsSinceEviction_ = 0;                  // when to next check whether records need to be evicted
+
+protected:
+    SmtDatabaseMemoizer(const std::string &url, size_t maxRecords);
+
+public:
+    ~SmtDatabaseMemoizer();
+
+    /** Allocating constructor.
+     *
+     *  Connect to the specified database, creating the tables if necessary. The @p maxRecords is the maximum number of
+     *  memoization records to store in the database, or zero for no limit. An @ref SmtSolver::Exception is thrown if the
+     *  database cannot be opened. */
+    static Ptr instance(const std::string &url, size_t maxRecords = 1000000);
+
+    /** Memoizer for the command-line.
+     *
+     *  Returns the process-wide memoizer for the database named by the "--smt-memoization" command-line switch, creating it the
+     *  first time it's called. Returns null if that switch was not specified. */
+    static Ptr fromCommandLine();
+
+    /** Property: Database URL.
+     *
+     *  The URL of the database that was opened. */
+    const std::string& url() const;
+
+    /** Property: Maximum number of records in the database.
+     *
+     *  Zero means no limit. This can be adjusted at any time, but records are evicted only when new records are inserted.
+     *
+     * @{ */
+    size_t maxRecords() const;
+    void maxRecords(size_t);
+    /** @} */
+
+    /** Statistics for this run. */
+    Stats statistics() const;
+
+    /** Print statistics. */
+    void print(std::ostream&, const std::string &prefix = "") const;
+
+    /** Clear the in-memory cache.
+     *
+     *  Only the in-memory layer is cleared. Records stored in the database are shared with other runs and are not affected. */
+    virtual void clear() override;
+
+    /** Search for the specified assertions in the in-memory cache and then the database. */
+    virtual Found find(const ExprList &assertions) override;
+
+    /** Insert a call record into the in-memory cache and the database. */
+    virtual void insert(const Found&, Satisfiable, const ExprExprMap &evidence) override;
+
+    /** Number of records in the database, or in the in-memory cache if there is no database connection. */
+    virtual size_t size() const override;
+
+private:
+    void initSchema();
+    void handleError(const std::exception&);
+    void evictNS();
+    void saveRunNS();
+};
+
+} // namespace
+} // namespace
+
+#endif
+#endif
@@ -102,6 +102,9 @@ public:
         size_t nSolversDestroyed = 0;                   /**< Number of solvers destroyed. Only for class statistics. */
         double prepareTime = 0.0;                       /**< Total time in seconds spent creating assertions before solving. */
         double longestPrepareTime = 0.0;                /**< Longest of times added to prepareTime. */
+        double translationTime = 0.0;                   /**< Part of prepareTime spent translating expressions for a library. */
+        double longestTranslationTime = 0.0;            /**< Longest of times added to translationTime. */
+        size_t translationCacheHits = 0;                /**< Subexpression translations reused from earlier assertions. */
         double solveTime = 0.0;                         /**< Total time in seconds spent in solver's solve function. */
         double longestSolveTime = 0.0;                  /**< Longest of times added to the solveTime total. */
         double evidenceTime = 0.0;                      /**< Total time in seconds to retrieve evidence of satisfiability. */
@@ -109,6 +112,8 @@ public:
         size_t nSatisfied = 0;                          /**< Number of times the solver returned "satisified". */
         size_t nUnsatisfied = 0;                        /**< Number of times the solver returned "unsatisfied". */
         size_t nUnknown = 0;                            /**< Number of times the solver returned "unknown". */
+        size_t nProcessesStarted = 0;                   /**< Number of persistent solver processes started. */
+        size_t nAssertionsReused = 0;                   /**< Assertions already present in a persistent solver process. */
         // Remember to add all data members to SmtSolver::resetStatistics() and SmtSolver::Stats::print()
 
         void print(std::ostream&, const std::string &prefix = "") const;
@@ -224,6 +229,9 @@ public:
      *  evidence needs to be returned, the cached evidence is de-normalized using the inverse of the temporary renaming map for the
      *  current input assertions.
      *
+     *  This memoizer lives only in memory. See @ref SmtDatabaseMemoizer for a subclass that also stores its results in a
+     *  database so they can be shared across runs and processes.
+     *
      *  Thread safety: All member functions are thread safe unless otherwise noted. */
     class Memoizer: public Sawyer::SharedObject {
     public:
@@ -243,7 +251,7 @@ public:
             }
         };
 
-    private:
+    protected:
         using ExprExpr = std::pair<SymbolicExpression::Ptr, SymbolicExpression::Ptr>;
 
         // The thing that is memoized
@@ -256,7 +264,7 @@ public:
         // Mapping from hash of sorted-normalized assertions to the memoization record.
         using Map = std::multimap<SymbolicExpression::Hash, Record>;
 
-    private:
+    protected:
         mutable SAWYER_THREAD_TRAITS::Mutex mutex_;     // protects the following data members
         Map map_;                                       // memoization records indexed by hash of sorted-normalized assertions
 
@@ -268,7 +276,7 @@ public:
         static Ptr instance();
 
         /** Clear the entire cache as if it was just constructed. */
-        void clear();
+        virtual void clear();
 
         /** Search for the specified assertions in the cache.
          *
@@ -278,14 +286,14 @@ public:
          *  for the SMT solver results to be inserted into the cache later by the @ref insert function.
          *
          *  The documentation for this class describes how the search works by sorting and normalizing the input assertions. */
-        Found find(const ExprList &assertions);
+        virtual Found find(const ExprList &assertions);
 
         /** Returns evidence of satisfiability.
          *
          *  The argument is the result from @ref find. If the argument evaluates to true in Boolean context (i.e., the @ref find
          *  was a cache hit) then this function will de-normalize the cached evidence of satisfiability and return it. This function
          *  should not be called if the argument evaluates to false in a Boolean context (i.e., the @ref find was a cache miss). */
-        ExprExprMap evidence(const Found&) const;
+        virtual ExprExprMap evidence(const Found&) const;
 
         /** Insert a call record into the cache.
          *
@@ -293,14 +301,18 @@ public:
          *  the results from the SMT solver for the same assertions that were used in the @ref find call. The evidence is normalized
          *  using the same variable mapping as was used for the input assertions during the @ref find call, and then stored in the
          *  cache in normalized form. */
-        void insert(const Found&, Satisfiable, const ExprExprMap &evidence);
+        virtual void insert(const Found&, Satisfiable, const ExprExprMap &evidence);
 
         /** Number of call records cached. */
-        size_t size() const;
+        virtual size_t size() const;
 
     public:
         // Non-synchronized search for the sorted-normalized assertions which have the specified hash.
         Map::iterator searchNS(SymbolicExpression::Hash, const ExprList &sortedNormalized);
+
+    protected:
+        // Rename the variables in the evidence using the same mapping as was used for the assertions.
+        static ExprExprMap normalizeEvidence(const Found&, const ExprExprMap &evidence);
     };
 
 private:
@@ -387,7 +399,10 @@ public:
      *  Create a new solver using one of the names returned by @ref availability. The special name "" means no solver (return
      *  null) and "best" means return @ref bestAvailable (which might also be null). It may be possible to create solvers by
      *  name that are not available, but attempting to use such a solver will fail loudly by calling @ref requireLinkage. If an
-     *  invalid name is supplied then an @ref SmtSolver::Exception is thrown. */
+     *  invalid name is supplied then an @ref SmtSolver::Exception is thrown.
+     *
+     *  If a persistent memoization database was specified with the "--smt-memoization" command-line switch, then the returned
+     *  solver uses that database as its @ref memoizer. */
     static Ptr instance(const std::string &name);
 
     /** Best available solver.
@@ -495,8 +510,9 @@ public:
      *  Pushes a new, empty set of assertions onto the solver stack.
      *
      *  Note that although text-based solvers (executables) accept push and pop methods, they have no effect on the speed of
-     *  the solver because ROSE invokes the executable in batch mode. In this case the push and pop apply to the stack within
-     *  this solver object in ROSE.
+     *  the solver because ROSE normally invokes the executable in batch mode. In this case the push and pop apply to the stack
+     *  within this solver object in ROSE. See @ref SmtlibSolver::persistent for a mode where push and pop are forwarded to a
+     *  long-running solver process.
      *
      *  See also, @ref pop. */
     virtual void push();
@@ -6,6 +6,8 @@
 #include <Rose/BinaryAnalysis/SmtSolver.h>
 #include <boost/filesystem.hpp>
 #include <boost/unordered_map.hpp>
+#include <Sawyer/Stopwatch.h>
+#include <set>
 
 namespace Rose {
 namespace BinaryAnalysis {
@@ -13,12 +15,28 @@ namespace BinaryAnalysis {
 /** Wrapper around solvers that speak SMT-LIB. */
 class SmtlibSolver: public SmtSolver {
 private:
+    // What a persistent solver process knows about one level of the ROSE assertion stack.
+    struct SentLevel {
+        size_t nAssertions = 0;                         // number of assertions from this level already sent
+        std::set<std::string> names;                    // variables, terms, and functions declared at this level
+    };
+
     boost::filesystem::path executable_;                // solver program
     std::string shellArgs_;                             // extra arguments for command (passed through shell)
     ExprExprMap varsForSets_;                           // variables to use for sets
 
+    // Persistent solver process. Only persistent_ is copied by create().
+    bool persistent_ = false;                           // use a long-running solver process instead of one per check
+    int childPid_ = -1;                                 // process ID of the solver, or -1 if not running
+    int childFd_ = -1;                                  // socket connected to the solver's standard input and output
+    std::string childInput_;                            // bytes read from the solver but not yet consumed
+    std::vector<SentLevel> sent_;                       // parallel with the assertion stack up to what's been sent
+    size_t nPendingPops_ = 0;                           // levels popped in ROSE but not yet in the solver
+    bool needReset_ = false;                            // solver needs to be reset before sending more assertions
+
 protected:
     Sawyer::Optional<boost::chrono::duration<double> > timeout_; // max time for solving a single set of equations in seconds
+    size_t cseId_ = 0;                                  // ID of last common subexpression term emitted
 
 protected:
     // Reference counted. Use instance() or create() instead.
@@ -26,6 +44,9 @@ protected:
                           unsigned linkages = LM_EXECUTABLE)
         : SmtSolver(name, linkages), executable_(executable), shellArgs_(shellArgs) {}
 
+public:
+    ~SmtlibSolver();
+
 public:
     /** Construct a solver using the specified program.
      *
@@ -37,7 +58,9 @@ public:
      *  name. Beware that some tools might change directories as they run, so absolute names are usually best.  The optional @p
      *  shellArgs are the list of extra arguments to pass to the solver. WARNING: the entire command is pass to @c popen, which
      *  will invoke a shell to process the executable name and arguments; appropriate escaping of shell meta characters is the
-     *  responsibility of the caller. */
+     *  responsibility of the caller.
+     *
+     *  See also, @ref persistent. */
     static Ptr instance(const std::string &name, const boost::filesystem::path &executable, const std::string &shellArgs = "",
                         unsigned linkages = LM_EXECUTABLE) {
         return Ptr(new SmtlibSolver(name, executable, shellArgs, linkages));
@@ -45,8 +68,41 @@ public:
 
     virtual Ptr create() const override;
 
+public:
+    /** Property: Use a persistent solver process.
+     *
+     *  When this property is false (the default), each satisfiability check writes all assertions to a temporary file and
+     *  runs a new solver process on that file.
+     *
+     *  When this property is true, a single solver process is started the first time it's needed and kept alive for the
+     *  lifetime of this object. Assertions are streamed to the solver's standard input and results are read from its
+     *  standard output. Each level of this object's assertion stack corresponds to a solver "(push)" level, so assertions
+     *  that were sent for an earlier check are not sent again, and @ref pop and @ref reset are forwarded to the solver as
+     *  "(pop)" and "(reset)" commands just before the next check. This is how @ref SmtSolver::Transaction should be used to
+     *  get the most benefit from this mode.
+     *
+     *  If the solver process reports an error or dies, it is terminated and a new one is started for the next check with the
+     *  full assertion stack. If a timeout is set and the solver doesn't answer within the timeout plus a short grace
+     *  period, the process is killed, the check returns @ref SAT_UNKNOWN, and the next check starts a new process. Changing
+     *  this property terminates any running solver process.
+     *
+     *  The command that runs the process is returned by @ref getPersistentCommand.
+     *
+     * @{ */
+    bool persistent() const;
+    void persistent(bool);
+    /** @} */
+
+    /** Command to start a persistent solver process.
+     *
+     *  The returned command is passed to a shell and should start the solver in a mode that reads SMT-LIB commands from
+     *  standard input interactively. The default implementation uses the same executable and extra arguments as batch mode
+     *  followed by "-in", which is what Z3 expects. */
+    virtual std::string getPersistentCommand();
+
 public:
     virtual void reset() override;
+    virtual void pop() override;
     virtual void generateFile(std::ostream&, const std::vector<SymbolicExpression::Ptr> &exprs, Definitions*) override;
     virtual std::string getCommand(const std::string &configName) override;
     virtual std::string getErrorMessage(int exitStatus) override;
@@ -65,6 +121,19 @@ protected:
     /** @} */
 
     virtual void parseEvidence() override;
+    virtual Satisfiable checkExe() override;
+
+    /** Check satisfiability using a persistent solver process.
+     *
+     *  This is called by @ref checkExe when the @ref persistent property is set. It sends whatever parts of the assertion
+     *  stack the solver process hasn't seen yet, followed by "(check-sat)" and, if satisfiable, "(get-model)". */
+    virtual Satisfiable checkPersistent();
+
+    /** Generate SMT-LIB text for new assertions.
+     *
+     *  This is similar to @ref generateFile except it emits only the declarations, definitions, and assertions that the
+     *  persistent solver process doesn't already have, and it updates the record of what has been sent. */
+    virtual void generateIncrement(std::ostream&);
 
     /** Generate definitions for bit-wise XOR functions.
      *
@@ -161,6 +230,18 @@ protected:
     virtual void outputComments(std::ostream&, const std::vector<SymbolicExpression::Ptr>&);
     virtual void outputCommonSubexpressions(std::ostream&, const std::vector<SymbolicExpression::Ptr>&);
     virtual void outputAssertion(std::ostream&, const SymbolicExpression::Ptr&);
+
+    // Commands sent to a persistent solver process when it starts or is reset.
+    virtual void outputPersistentOptions(std::ostream&);
+
+private:
+    // Persistent solver process management.
+    void startChild();
+    void stopChild();
+    void sendToChild(const std::string&);
+    Sawyer::Optional<std::string> readFromChild(const Sawyer::Stopwatch&); // read one S-expression; nothing if time ran out
+    Sawyer::Optional<double> childTimeLimit() const;    // seconds to wait for a response before killing the solver
+    bool isSent(const std::string &name) const;
 };
 
 } // namespace
@@ -19,6 +19,7 @@
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/unordered_map.hpp>
+#include <atomic>
 #include <cassert>
 #include <inttypes.h>
 #include <Rose/Exception.h>
@@ -466,6 +467,9 @@ protected:
     std::string comment_;             /**< Optional comment. Only for debugging; not significant for any calculation. */
     mutable Hash hashval_;            /**< Optional hash used as a quick way to indicate that two expressions are different. */
     boost::any userData_;             /**< Additional user-specified data. This is not part of the hash. */
+    std::atomic<bool> interned_;      /**< Node is the canonical node in the intern table. Set only by the table. */
+
+    friend class InternTable;
 
 #ifdef ROSE_HAVE_BOOST_SERIALIZATION_LIB
 private:
@@ -507,9 +511,9 @@ public:
 
 protected:
     Node()
-        : type_(Type::integer(0)), flags_(0), hashval_(0) {}
+        : type_(Type::integer(0)), flags_(0), hashval_(0), interned_(false) {}
     explicit Node(const std::string &comment, unsigned flags=0)
-        : type_(Type::integer(0)), flags_(flags), comment_(comment), hashval_(0) {}
+        : type_(Type::integer(0)), flags_(flags), comment_(comment), hashval_(0), interned_(false) {}
 
 public:
     /** Type of value. */
@@ -813,6 +817,14 @@ public:
      *  is computed and cached. */
     Hash hash() const;
 
+    /** Returns true if this node is the canonical node from the intern table.
+     *
+     *  Two distinct interned nodes are never structurally equivalent, so comparing them is a pointer comparison. See @ref
+     *  interning. */
+    bool isInterned() const {
+        return interned_.load(std::memory_order_acquire);
+    }
+
     // used internally to set the hash value
     void hash(Hash) const;
 
@@ -1366,6 +1378,71 @@ private:
     static uint64_t nextNameCounter(uint64_t useThis = (uint64_t)(-1));
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Hash consing
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Statistics for interned expression nodes. */
+struct InternStats {
+    size_t nLookups = 0;                                /**< Number of nodes looked up in the intern table. */
+    size_t nHits = 0;                                   /**< Number of lookups that returned an existing node. */
+    size_t nLive = 0;                                   /**< Number of nodes currently in the intern table. */
+    size_t nBytes = 0;                                  /**< Approximate memory used by the nodes in the intern table. */
+    size_t nSweeps = 0;                                 /**< Number of times the table was swept for unused nodes. */
+    size_t nSwept = 0;                                  /**< Number of unused nodes removed from the table. */
+
+    /** Fraction of lookups that were hits. Returns zero if there were no lookups. */
+    double hitRate() const {
+        return nLookups > 0 ? (double)nHits / nLookups : 0.0;
+    }
+
+    /** Print statistics, one per line. */
+    void print(std::ostream&, const std::string &prefix = "") const;
+};
+
+/** Property: Whether new expression nodes are interned.
+ *
+ *  When interning is enabled, the @ref Interior::instance and @ref Leaf factories look up each newly created node in a global
+ *  table keyed by the node's hash and return the existing node if one is structurally equivalent (same type, flags, operator,
+ *  and children, or same value). Since children are interned before their parents, equal subtrees become pointer-equal,
+ *  which saves memory and makes @ref Node::isEquivalentTo and hash-based containers much cheaper.
+ *
+ *  Comments and user data are not significant for structural equivalence, therefore an interned node keeps the comment of
+ *  whichever equivalent node was interned first. Callers that need distinct comments on equal expressions should not enable
+ *  interning.
+ *
+ *  The table holds references to its nodes but periodically sweeps out nodes that are referenced only by the table, so it
+ *  behaves like a weak table. The table is divided into independently locked shards so it can be used concurrently.
+ *  Interning is disabled by default. Disabling it stops new lookups but does not clear the table.
+ *
+ * @{ */
+bool interning();
+void interning(bool);
+/** @} */
+
+/** Intern an expression node.
+ *
+ *  Returns the canonical node that is structurally equivalent to the argument, inserting the argument into the intern table
+ *  if there is no such node. Only the top node is looked up; its children are assumed to be interned already if they're
+ *  going to be. This function works regardless of whether @ref interning is enabled. Thread safe. */
+Ptr intern(const Ptr&);
+
+/** Statistics for the intern table.
+ *
+ *  Computing the live-node counts requires locking and scanning the whole table. Thread safe. */
+InternStats internStatistics();
+
+/** Reset intern table counters.
+ *
+ *  Resets the lookup, hit, and sweep counters. The table itself is not changed. */
+void resetInternStatistics();
+
+/** Remove unused nodes from the intern table.
+ *
+ *  Removes all nodes that are referenced only by the intern table and returns the number removed. This happens
+ *  automatically as the table grows, but can be called explicitly before measuring memory. */
+size_t sweepInternTable();
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Factories
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -497,6 +497,19 @@ public:
     std::string unparse(const Partitioner2::PartitionerConstPtr&, const Partitioner2::FunctionPtr&) const /*final*/;
     /** @} */
 
+    /** High-level unparsing function using multiple threads.
+     *
+     *  Emits all functions, the same as the @ref unparse function that takes no entity argument, but renders the functions
+     *  in parallel using the number of threads specified by the global "--threads" command-line switch. Each worker thread
+     *  renders whole functions into text buffers using its own copy of the unparser @ref State, and the buffers are written
+     *  to the output stream in order of function address. The output is therefore identical to that of the serial version.
+     *
+     *  The serial version is used if only one thread is requested, or if @ref initializeState created user-defined
+     *  @ref State::globalBlockArrows "global arrows", since those arrows span function boundaries. Unparsers that are
+     *  subclassed or chained must not carry state from one function to the next except through global arrows. */
+    void unparseInParallel(std::ostream&, const Partitioner2::PartitionerConstPtr&,
+                           const Progress::Ptr& = Progress::Ptr()) const /*final*/;
+
 public:
     /** Mid-level unparser function.
      *
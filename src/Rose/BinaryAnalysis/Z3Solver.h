@@ -48,6 +48,24 @@ private:
 
     // Expressions that we need to hold on to for allocation/deallocation purposes until the translation process is completed.
     std::vector<SymbolicExpression::Ptr> holdingExprs_;
+
+    // Interior nodes whose translations must not be reused by later assertions because they depend on the free variables
+    // that are created for sets each time an assertion is translated. Cleared along with ctxCses_.
+    std::set<const SymbolicExpression::Node*> ctxUncacheable_;
+
+    // Translations of interior nodes that survive from one assertion to the next for the lifetime of ctx_. The cache is keyed
+    // by the expression hash, and each entry holds a reference to the expression that was translated so hash collisions can
+    // be detected. Each entry belongs to the z3Stack_ level at which it was created, and ctxCacheLevels_ (parallel with
+    // z3Stack_) records the keys created at each level so they can be removed when the level is popped.
+    struct TranslationCacheEntry {
+        SymbolicExpression::Ptr expr;
+        Z3ExprTypePair et;
+        TranslationCacheEntry(const SymbolicExpression::Ptr &expr, const Z3ExprTypePair &et)
+            : expr(expr), et(et) {}
+    };
+    typedef Sawyer::Container::Map<SymbolicExpression::Hash, TranslationCacheEntry> TranslationCache;
+    TranslationCache ctxCache_;
+    std::vector<std::vector<SymbolicExpression::Hash> > ctxCacheLevels_;
 #endif
 
 private:
@@ -62,6 +80,7 @@ private:
         // z3Stack_     -- not serialized
         // ctxCses_     -- not serialized
         // ctxVarDecls_ -- not serialized
+        // ctxCache_    -- not serialized
     }
 #endif
 
@@ -77,6 +96,7 @@ protected:
         ctx_ = new z3::context;
         solver_ = new z3::solver(*ctx_);
         z3Stack_.push_back(std::vector<z3::expr>());
+        ctxCacheLevels_.push_back(std::vector<SymbolicExpression::Hash>());
 #endif
     }
 
@@ -85,6 +105,7 @@ public:
 #ifdef ROSE_HAVE_Z3
         ctxVarDecls_.clear();
         ctxCses_.clear();
+        ctxCache_.clear();
         z3Stack_.clear();
         delete solver_;
         delete ctx_;
@@ -186,6 +207,9 @@ protected:
     std::vector<Z3Solver::Z3ExprTypePair> ctxCast(const std::vector<Z3ExprTypePair>&, Type toType);
     Z3ExprTypePair ctxLeaf(const SymbolicExpression::Leaf*);
     Z3ExprTypePair ctxExpression(SymbolicExpression::Node*);
+    Z3ExprTypePair ctxTranslate(SymbolicExpression::Node*);
+    void ctxCacheInsert(SymbolicExpression::Node*, const Z3ExprTypePair&);
+    void ctxCachePop(size_t nLevels);
     std::vector<Z3Solver::Z3ExprTypePair> ctxExpressions(const std::vector<SymbolicExpression::Ptr>&);
     void ctxVariableDeclarations(const VariableSet&);
     void ctxCommonSubexpressions(const SymbolicExpression::Ptr&);
@@ -96,6 +96,9 @@ struct GenericSwitchArgs {
                                                          *   The empty string means no solver is used. Additional switches
                                                          *   might be present to override this global solver for specific
                                                          *   situations. */
+    std::string smtMemoization;                         /**< URL of a database in which SMT solver results are memoized across
+                                                         *   runs and processes. The empty string means results are not
+                                                         *   memoized persistently. */
     bool errorIfDisabled;                               /**< Controls behavior of a tool when disabled. If true (the default)
                                                          *   and a tool's primary feature set is disabled (such as when ROSE is
                                                          *   compiled with too old a compiler or without the necessary
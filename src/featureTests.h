@@ -94,6 +94,15 @@
 #define ROSE_ENABLE_LIBRARY_IDENTIFICATION
 #endif
 
+// Whether SMT solver memoization can be stored persistently in a database.
+//   * Requires a mechanism by which to store results (SQLite or PostgreSQL)
+//   * Requires a way to serialize symbolic expressions (boost::serialization)
+#if !defined(ROSE_ENABLE_SMT_MEMOIZATION_DATABASE) && \
+    (defined(ROSE_HAVE_SQLITE3) || defined(ROSE_HAVE_LIBPQXX)) && \
+    defined(ROSE_HAVE_BOOST_SERIALIZATION_LIB)
+#define ROSE_ENABLE_SMT_MEMOIZATION_DATABASE
+#endif
+
 // Whether to enable Model checking. The model checker was designed to run in multiple threads. Some parts of the API don't
 // even make sense for a single thread.
 #if !defined(ROSE_ENABLE_MODEL_CHECKER) && \
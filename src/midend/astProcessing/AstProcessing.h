@@ -89,6 +89,8 @@ typedef DummyAttribute _DummyAttribute;
 template <class InheritedAttributeType, class SynthesizedAttributeType>
 class SgCombinedTreeTraversal;
 
+class AstSubtreeParallelProcessing;
+
 
 
 
@@ -120,6 +122,7 @@ public:
     const SgTreeTraversal &operator=(const SgTreeTraversal &);
 
     friend class SgCombinedTreeTraversal<InheritedAttributeType, SynthesizedAttributeType>;
+    friend class AstSubtreeParallelProcessing;
    
 
 #include "Cxx_GrammarTreeTraversalAccessEnums.h"
@@ -984,4 +987,6 @@ atTraversalEnd()
   #include "AstSharedMemoryParallelProcessing.h"
 #endif
 
+#include "AstSubtreeParallelProcessing.h"
+
 #endif
@@ -0,0 +1,177 @@
+// Classes for data-parallel (multithreaded) evaluation of a single traversal.
+//
+// The AstSharedMemoryParallel*Processing classes run several different traversals over the same AST at the same time, but
+// each of those traversals still runs on a single thread. The AstSubtreeParallel*Processing classes instead split the AST
+// at nodes of user-chosen types (function definitions by default) and evaluate one traversal on each of the resulting
+// subtrees in parallel.
+//
+// The traversal is evaluated as follows:
+//   1. The part of the AST above the split nodes is traversed top-down by the calling thread using the traversal object
+//      supplied by the user, and the inherited attribute for each split node is recorded. The root of the traversal is
+//      never a split node.
+//   2. Each split node's subtree is a task. The tasks are distributed among worker threads that steal tasks from each
+//      other when they run out of work. Each task evaluates the subtree using its own copy of the traversal object, made
+//      with the traversal's copy constructor from the state the original had just after atTraversalStart() was called
+//      (i.e., before any node was visited).
+//   3. The optional merge function is called in the calling thread for each task's copy of the traversal, in the order in
+//      which the split nodes would be visited by a serial traversal.
+//   4. The part of the AST above the split nodes is traversed bottom-up by the calling thread using the original traversal
+//      object. The synthesized attributes computed by the tasks are passed to evaluateSynthesizedAttribute() in their usual
+//      positions, so the final result is identical to that of a serial traversal.
+//
+// Each node is visited exactly once and the attributes at each node are evaluated with the same arguments as in a serial
+// traversal, but nodes in different subtrees are visited concurrently and all nodes above the split nodes are visited
+// top-down before any of them is visited bottom-up. This is intended for traversals that do not modify the AST and that
+// keep their results in attributes or in data members that are merged after the tasks finish, such as def-use collection
+// or metric gathering. As with the other parallel traversals, only traverse() is supported (not traverseWithinFile() or
+// traverseInputFiles()).
+
+#ifndef ASTSUBTREEPARALLELPROCESSING_H
+#define ASTSUBTREEPARALLELPROCESSING_H
+
+#include "AstProcessing.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Settings and the work-stealing task pool shared by all subtree-parallel traversals. The user will probably never need to
+// use this class directly, they should use the AstSubtreeParallel*Processing classes below instead.
+class ROSE_DLL_API AstSubtreeParallelProcessing
+{
+public:
+    // Creates a traversal that splits the AST at function definitions and uses one thread per hardware thread.
+    AstSubtreeParallelProcessing();
+
+    // Number of worker threads, including the calling thread. Zero means one per hardware thread.
+    void set_numberOfThreads(size_t threads);
+    size_t get_numberOfThreads() const;
+
+    // Node types at which the AST is split into tasks. Only nodes whose variantT() is exactly one of these types are split
+    // nodes; subclasses must be added separately. Split nodes below other split nodes belong to the outer node's task.
+    void add_splitVariant(VariantT variant);
+    void clear_splitVariants();
+    bool isSplitNode(SgNode *node) const;
+
+protected:
+    // Calls task(i) for each i in [0, nTasks) and returns when all of them have returned. Tasks are initially dealt out in
+    // contiguous blocks to the worker threads. If a task throws an exception, no further tasks are started and the first
+    // exception is rethrown in the calling thread after all workers have finished.
+    void runTasks(size_t nTasks, const std::function<void(size_t)> &task) const;
+
+    // Evaluates the traversal as described at the top of this file. The merge function is called as merge(traversal, copy)
+    // for each task's copy of the traversal.
+    template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType, class MergeFunction>
+    SynthesizedAttributeType traverseSubtrees(Traversal &traversal, SgNode *basenode,
+            InheritedAttributeType inheritedValue, t_traverseOrder treeTraversalOrder, MergeFunction merge);
+
+private:
+    static const size_t NO_TASK = (size_t)(-1);
+
+    // A node above the split nodes (or a successor that is not traversed, in which case node is null), recorded in
+    // preorder by collectSubtrees(). Successors follow their parent.
+    template <class InheritedAttributeType>
+    struct TopNode
+    {
+        SgNode *node;
+        InheritedAttributeType inheritedValue;
+        size_t numberOfSuccessors;
+        size_t task;
+
+        TopNode(SgNode *node, InheritedAttributeType inheritedValue, size_t task)
+            : node(node), inheritedValue(inheritedValue), numberOfSuccessors(0), task(task) {}
+    };
+
+    // The subtree rooted at a split node, and the results of evaluating it.
+    template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType>
+    struct SubtreeTask
+    {
+        SgNode *node;
+        InheritedAttributeType inheritedValue;
+        std::unique_ptr<Traversal> traversal;
+        SynthesizedAttributeType synthesizedValue;
+
+        SubtreeTask(SgNode *node, InheritedAttributeType inheritedValue)
+            : node(node), inheritedValue(inheritedValue), synthesizedValue() {}
+    };
+
+    template <class InheritedAttributeType, class SynthesizedAttributeType>
+    void successorsOf(SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal, SgNode *node,
+            std::vector<SgNode*> &successors) const;
+
+    template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType>
+    void collectSubtrees(SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal, SgNode *node,
+            InheritedAttributeType inheritedValue, t_traverseOrder treeTraversalOrder, bool isRoot,
+            std::vector<TopNode<InheritedAttributeType> > &topNodes,
+            std::vector<SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> > &tasks) const;
+
+    template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType>
+    void evaluateTopNodes(SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal,
+            const std::vector<TopNode<InheritedAttributeType> > &topNodes, size_t &index,
+            const std::vector<SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> > &tasks,
+            StackFrameVector<SynthesizedAttributeType> &synthesizedAttributes) const;
+
+    size_t numberOfThreads;
+    std::vector<bool> splitVariants;
+};
+
+// Subtree-parallel evaluation of an AstSimpleProcessing or AstPrePostProcessing traversal. For an AstPrePostProcessing
+// traversal, use preandpostorder as the traversal order.
+class ROSE_DLL_API AstSubtreeParallelSimpleProcessing
+    : public AstSubtreeParallelProcessing
+{
+public:
+    template <class Traversal>
+    void traverse(Traversal &traversal, SgNode *basenode, t_traverseOrder treeTraversalOrder);
+
+    // The merge function is called as merge(traversal, copy) for each subtree's copy of the traversal.
+    template <class Traversal, class MergeFunction>
+    void traverse(Traversal &traversal, SgNode *basenode, t_traverseOrder treeTraversalOrder, MergeFunction merge);
+};
+
+// Subtree-parallel evaluation of an AstTopDownBottomUpProcessing traversal.
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+class AstSubtreeParallelTopDownBottomUpProcessing
+    : public AstSubtreeParallelProcessing
+{
+public:
+    template <class Traversal>
+    SynthesizedAttributeType traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue);
+
+    // The merge function is called as merge(traversal, copy) for each subtree's copy of the traversal.
+    template <class Traversal, class MergeFunction>
+    SynthesizedAttributeType traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue,
+            MergeFunction merge);
+};
+
+// Subtree-parallel evaluation of an AstTopDownProcessing traversal.
+template <class InheritedAttributeType>
+class AstSubtreeParallelTopDownProcessing
+    : public AstSubtreeParallelProcessing
+{
+public:
+    template <class Traversal>
+    void traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue);
+
+    // The merge function is called as merge(traversal, copy) for each subtree's copy of the traversal.
+    template <class Traversal, class MergeFunction>
+    void traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue, MergeFunction merge);
+};
+
+// Subtree-parallel evaluation of an AstBottomUpProcessing traversal.
+template <class SynthesizedAttributeType>
+class AstSubtreeParallelBottomUpProcessing
+    : public AstSubtreeParallelProcessing
+{
+public:
+    template <class Traversal>
+    SynthesizedAttributeType traverse(Traversal &traversal, SgNode *basenode);
+
+    // The merge function is called as merge(traversal, copy) for each subtree's copy of the traversal.
+    template <class Traversal, class MergeFunction>
+    SynthesizedAttributeType traverse(Traversal &traversal, SgNode *basenode, MergeFunction merge);
+};
+
+#include "AstSubtreeParallelProcessingImpl.h"
+
+#endif
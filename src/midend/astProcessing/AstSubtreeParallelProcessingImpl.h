@@ -0,0 +1,242 @@
+// Template implementations for AstSubtreeParallelProcessing.h; see the comment at the top of that file.
+
+#ifndef ASTSUBTREEPARALLELPROCESSINGIMPL_H
+#define ASTSUBTREEPARALLELPROCESSINGIMPL_H
+
+#include "AstSubtreeParallelProcessing.h"
+
+// General traversal engine
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+void
+AstSubtreeParallelProcessing::successorsOf(
+        SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal,
+        SgNode *node,
+        std::vector<SgNode*> &successors) const
+{
+    // Same choice of successors as SgTreeTraversal::performTraversal()
+    successors.clear();
+    if (traversal.useDefaultIndexBasedTraversal)
+    {
+        size_t numberOfSuccessors = node->get_numberOfTraversalSuccessors();
+        successors.reserve(numberOfSuccessors);
+        for (size_t idx = 0; idx < numberOfSuccessors; idx++)
+            successors.push_back(node->get_traversalSuccessorByIndex(idx));
+    }
+    else
+    {
+        AstSuccessorsSelectors::SuccessorsContainer succContainer;
+        traversal.setNodeSuccessors(node, succContainer);
+        successors.assign(succContainer.begin(), succContainer.end());
+    }
+}
+
+template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType>
+void
+AstSubtreeParallelProcessing::collectSubtrees(
+        SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal,
+        SgNode *node,
+        InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder,
+        bool isRoot,
+        std::vector<TopNode<InheritedAttributeType> > &topNodes,
+        std::vector<SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> > &tasks) const
+{
+    typedef TopNode<InheritedAttributeType> TopNodeType;
+    typedef SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> TaskType;
+
+    if (node == NULL || !SgTreeTraversal_inFileToTraverse(node, traversal.traversalConstraint, traversal.fileToVisit))
+    {
+        // not traversed; gets the default synthesized attribute
+        topNodes.push_back(TopNodeType(NULL, inheritedValue, NO_TASK));
+        return;
+    }
+
+    if (!isRoot && isSplitNode(node))
+    {
+        // the whole subtree, including the split node itself, is evaluated by a task
+        topNodes.push_back(TopNodeType(node, inheritedValue, tasks.size()));
+        tasks.push_back(TaskType(node, inheritedValue));
+        return;
+    }
+
+    if (treeTraversalOrder & preorder)
+        inheritedValue = traversal.evaluateInheritedAttribute(node, inheritedValue);
+
+    size_t self = topNodes.size();
+    topNodes.push_back(TopNodeType(node, inheritedValue, NO_TASK));
+
+    std::vector<SgNode*> successors;
+    successorsOf(traversal, node, successors);
+    topNodes[self].numberOfSuccessors = successors.size();
+    for (size_t idx = 0; idx < successors.size(); idx++)
+        collectSubtrees(traversal, successors[idx], inheritedValue, treeTraversalOrder, false, topNodes, tasks);
+}
+
+template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType>
+void
+AstSubtreeParallelProcessing::evaluateTopNodes(
+        SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal,
+        const std::vector<TopNode<InheritedAttributeType> > &topNodes,
+        size_t &index,
+        const std::vector<SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> > &tasks,
+        StackFrameVector<SynthesizedAttributeType> &synthesizedAttributes) const
+{
+    const TopNode<InheritedAttributeType> &topNode = topNodes[index++];
+
+    if (topNode.node == NULL)
+    {
+        synthesizedAttributes.push(traversal.defaultSynthesizedAttribute(topNode.inheritedValue));
+    }
+    else if (topNode.task != NO_TASK)
+    {
+        synthesizedAttributes.push(tasks[topNode.task].synthesizedValue);
+    }
+    else
+    {
+        for (size_t idx = 0; idx < topNode.numberOfSuccessors; idx++)
+            evaluateTopNodes(traversal, topNodes, index, tasks, synthesizedAttributes);
+
+        // same stack protocol as SgTreeTraversal::performTraversal()
+        synthesizedAttributes.setFrameSize(topNode.numberOfSuccessors);
+        ROSE_ASSERT(synthesizedAttributes.size() == topNode.numberOfSuccessors);
+        synthesizedAttributes.push(traversal.evaluateSynthesizedAttribute(topNode.node, topNode.inheritedValue,
+                                                                          synthesizedAttributes));
+    }
+}
+
+template <class Traversal, class InheritedAttributeType, class SynthesizedAttributeType, class MergeFunction>
+SynthesizedAttributeType
+AstSubtreeParallelProcessing::traverseSubtrees(
+        Traversal &concreteTraversal,
+        SgNode *basenode,
+        InheritedAttributeType inheritedValue,
+        t_traverseOrder treeTraversalOrder,
+        MergeFunction merge)
+{
+    typedef SubtreeTask<Traversal, InheritedAttributeType, SynthesizedAttributeType> TaskType;
+    SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &traversal = concreteTraversal;
+
+    traversal.atTraversalStart();
+
+    // The tasks start from the state the traversal had before any node was visited
+    const Traversal prototype(concreteTraversal);
+
+    // Top-down over the nodes above the split nodes
+    std::vector<TopNode<InheritedAttributeType> > topNodes;
+    std::vector<TaskType> tasks;
+    collectSubtrees(traversal, basenode, inheritedValue, treeTraversalOrder, true, topNodes, tasks);
+
+    // The subtrees, in parallel. Each task writes only to its own element of the task list.
+    runTasks(tasks.size(), [&prototype, &tasks, treeTraversalOrder](size_t i) {
+            TaskType &task = tasks[i];
+            task.traversal.reset(new Traversal(prototype));
+            SgTreeTraversal<InheritedAttributeType, SynthesizedAttributeType> &copy = *task.traversal;
+            copy.synthesizedAttributes->resetStack();
+            copy.performTraversal(task.node, task.inheritedValue, treeTraversalOrder);
+            task.synthesizedValue = copy.traversalResult();
+        });
+
+    // Deterministic merge, in the order of a serial traversal
+    for (size_t i = 0; i < tasks.size(); i++)
+        merge(concreteTraversal, *tasks[i].traversal);
+
+    // Bottom-up over the nodes above the split nodes
+    SynthesizedAttributeType result = SynthesizedAttributeType();
+    if (treeTraversalOrder & postorder)
+    {
+        StackFrameVector<SynthesizedAttributeType> synthesizedAttributes;
+        size_t index = 0;
+        evaluateTopNodes(traversal, topNodes, index, tasks, synthesizedAttributes);
+        ROSE_ASSERT(index == topNodes.size());
+        ROSE_ASSERT(synthesizedAttributes.debugSize() == 1);
+        result = synthesizedAttributes.pop();
+    }
+
+    traversal.atTraversalEnd();
+    return result;
+}
+
+// SIMPLE processing
+
+template <class Traversal>
+void
+AstSubtreeParallelSimpleProcessing::traverse(Traversal &traversal, SgNode *basenode, t_traverseOrder treeTraversalOrder)
+{
+    traverse(traversal, basenode, treeTraversalOrder, [](Traversal &, Traversal &) {});
+}
+
+template <class Traversal, class MergeFunction>
+void
+AstSubtreeParallelSimpleProcessing::traverse(Traversal &traversal, SgNode *basenode, t_traverseOrder treeTraversalOrder,
+        MergeFunction merge)
+{
+    traverseSubtrees<Traversal, DummyAttribute, DummyAttribute>(traversal, basenode, defaultDummyAttribute,
+                                                                treeTraversalOrder, merge);
+}
+
+// TOP DOWN BOTTOM UP processing
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+template <class Traversal>
+SynthesizedAttributeType
+AstSubtreeParallelTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue)
+{
+    return traverse(traversal, basenode, inheritedValue, [](Traversal &, Traversal &) {});
+}
+
+template <class InheritedAttributeType, class SynthesizedAttributeType>
+template <class Traversal, class MergeFunction>
+SynthesizedAttributeType
+AstSubtreeParallelTopDownBottomUpProcessing<InheritedAttributeType, SynthesizedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue, MergeFunction merge)
+{
+    return this->template traverseSubtrees<Traversal, InheritedAttributeType, SynthesizedAttributeType>(
+            traversal, basenode, inheritedValue, preandpostorder, merge);
+}
+
+// TOP DOWN processing
+
+template <class InheritedAttributeType>
+template <class Traversal>
+void
+AstSubtreeParallelTopDownProcessing<InheritedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue)
+{
+    traverse(traversal, basenode, inheritedValue, [](Traversal &, Traversal &) {});
+}
+
+template <class InheritedAttributeType>
+template <class Traversal, class MergeFunction>
+void
+AstSubtreeParallelTopDownProcessing<InheritedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode, InheritedAttributeType inheritedValue, MergeFunction merge)
+{
+    // postorder is needed so that destroyInheritedValue() is called
+    this->template traverseSubtrees<Traversal, InheritedAttributeType, DummyAttribute>(
+            traversal, basenode, inheritedValue, preandpostorder, merge);
+}
+
+// BOTTOM UP processing
+
+template <class SynthesizedAttributeType>
+template <class Traversal>
+SynthesizedAttributeType
+AstSubtreeParallelBottomUpProcessing<SynthesizedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode)
+{
+    return traverse(traversal, basenode, [](Traversal &, Traversal &) {});
+}
+
+template <class SynthesizedAttributeType>
+template <class Traversal, class MergeFunction>
+SynthesizedAttributeType
+AstSubtreeParallelBottomUpProcessing<SynthesizedAttributeType>::
+traverse(Traversal &traversal, SgNode *basenode, MergeFunction merge)
+{
+    return this->template traverseSubtrees<Traversal, DummyAttribute, SynthesizedAttributeType>(
+            traversal, basenode, defaultDummyAttribute, postorder, merge);
+}
+
+#endif
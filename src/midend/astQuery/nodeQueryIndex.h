@@ -0,0 +1,96 @@
+#ifndef ROSE_NODE_QUERY_INDEX
+#define ROSE_NODE_QUERY_INDEX
+
+#include "nodeQuery.h"
+#include "rosedll.h"
+
+#include <unordered_map>
+#include <vector>
+
+/************************************************************************************************************************
+ * The class
+ *    NodeQueryIndex
+ * answers the same variant queries as NodeQuery::querySubTree(subTree, VariantT) and
+ * NodeQuery::querySubTree(subTree, VariantVector) without traversing the subtree.
+ *
+ * The index numbers the nodes below a root in preorder and records, for each node, its own number and the largest number
+ * that may be used in its subtree, so that the nodes of a subtree are exactly the nodes whose numbers lie in that interval.
+ * For each variant it keeps a sorted array of the numbers and nodes of that variant. A query is therefore two binary searches
+ * per variant plus a copy, and returns the nodes in the same order as the traversal-based query.
+ *
+ * The index is not updated automatically when the AST is modified. After modifying the AST (e.g. with SageInterface), either
+ * call invalidate(), which causes the index to be rebuilt by the next query, or call update() with the root of the modified
+ * subtree. Numbers are assigned with gaps so that most updates only renumber the modified subtree.
+ *
+ * Type nodes are found by the variant queries even when they are not traversed, so queries for SgType variants and queries
+ * rooted at nodes that are not in the index are forwarded to NodeQuery::querySubTree().
+ ***********************************************************************************************************************/
+class ROSE_DLL_API NodeQueryIndex
+   {
+     public:
+       //! Numbers assigned to a node: its own preorder number and the largest number that may be used in its subtree.
+          struct Range
+             {
+               size_t first;
+               size_t last;
+             };
+
+     private:
+          struct VariantList
+             {
+               std::vector<size_t> numbers;
+               std::vector<SgNode*> nodes;
+             };
+
+          SgNode* root;
+          bool valid;
+          std::unordered_map<SgNode*, Range> ranges;
+          std::vector<VariantList> variantLists;
+          std::vector<VariantVector> expandedVariants;
+
+     public:
+       //! Creates an empty index; call build() before querying.
+          NodeQueryIndex();
+
+       //! Creates an index of the subtree rooted at the specified node.
+          explicit NodeQueryIndex(SgNode* root);
+
+       //! Indexes the subtree rooted at the specified node, replacing any previous contents.
+          void build(SgNode* root);
+
+       //! Marks the index as out of date; it is rebuilt from the same root by the next query.
+          void invalidate();
+
+       //! Renumbers the subtree rooted at the specified node after it was modified. The node must be in the index and must
+       //! contain all of the modifications (e.g. the scope into which statements were inserted). If there are not enough
+       //! unused numbers for the new subtree, the index is invalidated instead.
+          void update(SgNode* subTree);
+
+       //! True if the index is up to date (i.e., it was built and has not been invalidated since).
+          bool isValid() const;
+
+       //! The root of the indexed subtree.
+          SgNode* get_root() const;
+
+       //! Number of indexed nodes.
+          size_t size() const;
+
+       //! True if the node is in the index.
+          bool contains(SgNode* node) const;
+
+       //! True if the second node is in the subtree rooted at the first node (including the first node itself).
+          bool isInSubTree(SgNode* subTree, SgNode* node);
+
+       //! Same result as NodeQuery::querySubTree(subTree, targetVariant), which includes subclasses of the target variant.
+          NodeQuerySynthesizedAttributeType querySubTree(SgNode* subTree, VariantT targetVariant);
+
+       //! Same result as NodeQuery::querySubTree(subTree, targetVariantVector).
+          NodeQuerySynthesizedAttributeType querySubTree(SgNode* subTree, const VariantVector & targetVariantVector);
+
+     private:
+          void buildIfNeeded();
+          bool isTypeVariant(VariantT variant);
+   };
+
+// endif for ROSE_NODE_QUERY_INDEX
+#endif
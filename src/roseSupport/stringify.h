@@ -316,7 +316,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 37
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 38
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::SearchMode enum constant to a string. */
     const char* SearchMode(int64_t);
@@ -334,7 +334,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 44
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 46
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::SemanticMemoryParadigm enum constant to a string. */
     const char* SemanticMemoryParadigm(int64_t);
@@ -352,7 +352,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 50
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 53
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::EdgeVisitOrder enum constant to a string. */
     const char* EdgeVisitOrder(int64_t);
@@ -370,7 +370,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 57
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 60
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::IoMode enum constant to a string. */
     const char* IoMode(int64_t);
@@ -388,7 +388,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 60
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 63
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::MayOrMust enum constant to a string. */
     const char* MayOrMust(int64_t);
@@ -406,7 +406,7 @@ namespace Rose {
 }
 
 // DO NOT EDIT -- This implementation was automatically generated for the enum defined at
-// /src/Rose/BinaryAnalysis/FeasiblePath.h line 180
+// /src/Rose/BinaryAnalysis/FeasiblePath.h line 189
 namespace stringify { namespace Rose { namespace BinaryAnalysis { namespace FeasiblePath { namespace PathProcessor {
     /** Convert Rose::BinaryAnalysis::FeasiblePath::PathProcessor::Action enum constant to a string. */
     const char* Action(int64_t);
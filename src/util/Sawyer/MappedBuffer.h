@@ -163,6 +163,8 @@ public:
     }
 
     Address write(const Value *buf, Address address, Address n) /*override*/ {
+        if (device_.flags() == boost::iostreams::mapped_file::readonly)
+            return 0;
         Address nwritten = std::min(n, available(address));
         memcpy(device_.data() + address, buf, nwritten * sizeof(Value));
         return nwritten;
@@ -281,6 +281,13 @@ Sawyer::CommandLine::Switch stateFileFormatSwitch(Rose::BinaryAnalysis::SerialIo
 /** Check that output file name is valid or exit. */
 void checkRbaOutput(const boost::filesystem::path &name, Sawyer::Message::Facility &mlog);
 
+/** Read a partitioner that the tool will only query.
+ *
+ *  An indexed RBA file other than standard input is read lazily so that only the parts of the partitioner that the tool's
+ *  queries need are loaded. Other RBA files are read completely. */
+Rose::BinaryAnalysis::Partitioner2::PartitionerPtr
+readPartitionerForQueries(const boost::filesystem::path &name, Rose::BinaryAnalysis::SerialIo::Format fmt);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Functions for selecting things
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////